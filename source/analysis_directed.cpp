@@ -0,0 +1,10 @@
+// Instanciations de runAnalysis pour les graphes orientés (--directed) : adjacency_list et
+// CSR figé dans chaque combinaison poids double / float et indices 64 / 32 bits (graph_config.hpp)
+
+#include "graph_analysis.hpp"
+
+template void runAnalysis<DirectedGraph>(DirectedGraph&, const RunOptions&);
+template void runAnalysis<BasicCsrGraph<DirectedConfig>>(BasicCsrGraph<DirectedConfig>&, const RunOptions&);
+template void runAnalysis<BasicCsrGraph<DirectedNarrowConfig>>(BasicCsrGraph<DirectedNarrowConfig>&, const RunOptions&);
+template void runAnalysis<BasicCsrGraph<DirectedFloatConfig>>(BasicCsrGraph<DirectedFloatConfig>&, const RunOptions&);
+template void runAnalysis<BasicCsrGraph<DirectedCompactConfig>>(BasicCsrGraph<DirectedCompactConfig>&, const RunOptions&);
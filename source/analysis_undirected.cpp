@@ -0,0 +1,10 @@
+// Instanciations de runAnalysis pour les graphes non orientés : adjacency_list et CSR figé
+// dans chaque combinaison poids double / float et indices 64 / 32 bits (graph_config.hpp)
+
+#include "graph_analysis.hpp"
+
+template void runAnalysis<Graph>(Graph&, const RunOptions&);
+template void runAnalysis<BasicCsrGraph<UndirectedConfig>>(BasicCsrGraph<UndirectedConfig>&, const RunOptions&);
+template void runAnalysis<BasicCsrGraph<UndirectedNarrowConfig>>(BasicCsrGraph<UndirectedNarrowConfig>&, const RunOptions&);
+template void runAnalysis<BasicCsrGraph<UndirectedFloatConfig>>(BasicCsrGraph<UndirectedFloatConfig>&, const RunOptions&);
+template void runAnalysis<BasicCsrGraph<UndirectedCompactConfig>>(BasicCsrGraph<UndirectedCompactConfig>&, const RunOptions&);
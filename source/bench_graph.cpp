@@ -0,0 +1,297 @@
+// Benchmark des étapes de l'analyse sur des graphes synthétiques (graph_generators.hpp)
+// usage : ./output/bench_graph [--generators=rgg,grid,scalefree] [--edges=1000,10000,...]
+//                              [--reps=N] [--warmup=N] [--queries=N] [--threads=N]
+//                              [--dir=D] [--output=F] [--label=L] [--seed=S]
+// par défaut : les trois générateurs, 1e3 à 1e6 arêtes, D = bench_data, F = bench_results.csv
+// pour chaque générateur et chaque taille : écrit D/<générateur>_<arêtes>_nodes.csv et _edges.csv,
+// puis chronomètre séparément loadNodes, loadEdges, isConnected, hasCycle, shortestPath
+// et writePathsToCSV (warmup passes non mesurées, puis reps passes mesurées ; shortestPath :
+// une mesure par requête, `queries` paires tirées au hasard par passe)
+// les résultats (min, percentiles, max, moyenne en ms) sont ajoutés à F (CSV, une ligne par étape) ;
+// --label (par ex. le commit) permet de comparer les exécutions entre elles
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "graph_types.hpp"
+#include "graph_generators.hpp"
+#include "graph_io.hpp"
+#include "graph_algorithms.hpp"
+
+struct BenchOptions {
+    std::vector<GeneratorKind> generators = { GeneratorKind::Geometric, GeneratorKind::Grid, GeneratorKind::ScaleFree };
+    std::vector<std::size_t> edges = { 1000, 10000, 100000, 1000000 };
+    int reps = 5;
+    int warmup = 1;
+    int queries = 10;
+    unsigned threads = 1;
+    std::string dir = "bench_data";
+    std::string output = "bench_results.csv";
+    std::string label;
+    std::uint64_t seed = 42;
+};
+
+// Les fonctions mesurées affichent leur progression sur std::cout :
+// elle est coupée pendant les mesures
+class QuietCout {
+public:
+    QuietCout() : _saved(std::cout.rdbuf(nullptr)) {}
+    ~QuietCout() {
+        std::cout.rdbuf(_saved);
+        std::cout.clear();
+    }
+
+private:
+    std::streambuf* _saved;
+};
+
+// Répartition des temps d'une étape (ms)
+struct PhaseStats {
+    std::string phase;
+    std::size_t samples = 0;
+    double min = 0, p50 = 0, p90 = 0, p99 = 0, max = 0, mean = 0;
+};
+
+// Percentile au rang le plus proche sur des mesures triées
+double percentile(const std::vector<double>& sorted, double q) {
+    std::size_t rank = static_cast<std::size_t>(std::ceil(q * sorted.size()));
+    return sorted[std::min(sorted.size() - 1, rank ? rank - 1 : 0)];
+}
+
+PhaseStats summarize(const std::string& phase, std::vector<double> samples) {
+    PhaseStats s;
+    s.phase = phase;
+    s.samples = samples.size();
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    s.min = samples.front();
+    s.max = samples.back();
+    s.p50 = percentile(samples, 0.50);
+    s.p90 = percentile(samples, 0.90);
+    s.p99 = percentile(samples, 0.99);
+    double total = 0;
+    for (double v : samples) total += v;
+    s.mean = total / samples.size();
+    return s;
+}
+
+// warmup + reps exécutions de run(), setup() avant chacune (non mesuré)
+template <class Setup, class Run>
+std::vector<double> measure(const BenchOptions& opt, Setup setup, Run run) {
+    std::vector<double> samples;
+    for (int r = 0; r < opt.warmup + opt.reps; ++r) {
+        setup();
+        QuietCout quiet;
+        auto t0 = std::chrono::steady_clock::now();
+        run();
+        auto t1 = std::chrono::steady_clock::now();
+        if (r >= opt.warmup) samples.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    return samples;
+}
+
+template <class Run>
+std::vector<double> measure(const BenchOptions& opt, Run run) {
+    return measure(opt, []() {}, run);
+}
+
+// Graphe effectivement chargé
+struct GraphInfo {
+    std::size_t vertices = 0, edges = 0;
+    bool connected = false, cycle = false;
+};
+
+std::vector<PhaseStats> benchGraph(const BenchOptions& opt, const std::string& nodesFile, const std::string& edgesFile,
+                                   GraphInfo& info) {
+    std::vector<PhaseStats> phases;
+    std::vector<NodeInfo> nodes;
+    phases.push_back(summarize("loadNodes", measure(opt, [&]() { nodes = loadNodes(nodesFile); })));
+
+    Graph g;
+    auto freshGraph = [&]() { assignNodes(g, nodes); };
+    phases.push_back(summarize("loadEdges", measure(opt, freshGraph, [&]() { loadEdges(g, edgesFile, opt.threads); })));
+    info.vertices = boost::num_vertices(g);
+    info.edges = boost::num_edges(g);
+
+    phases.push_back(summarize("isConnected", measure(opt, [&]() { info.connected = isConnected(g, opt.threads); })));
+    phases.push_back(summarize("hasCycle", measure(opt, [&]() { info.cycle = hasCycle(g); })));
+
+    // mêmes paires pour shortestPath et writePathsToCSV, tirées une fois pour toutes
+    std::mt19937_64 rng(opt.seed);
+    std::uniform_int_distribution<int> node(1, static_cast<int>(nodes.size()));
+    std::vector<NodePair> pairs;
+    for (int q = 0; q < opt.queries; ++q) pairs.push_back(std::make_pair(node(rng), node(rng)));
+
+    std::vector<double> queryTimes;
+    for (int r = 0; r < opt.warmup + opt.reps; ++r) {
+        QuietCout quiet;
+        for (const auto& p : pairs) {
+            auto t0 = std::chrono::steady_clock::now();
+            PathResult result = shortestPath(g, p.first, p.second);
+            auto t1 = std::chrono::steady_clock::now();
+            if (r >= opt.warmup) queryTimes.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        }
+    }
+    phases.push_back(summarize("shortestPath", queryTimes));
+
+    std::string pathsFile = opt.dir + "/bench_paths.csv";
+    phases.push_back(summarize("writePathsToCSV", measure(opt, [&]() {
+        writePathsToCSV(g, pairs, pathsFile, opt.threads);
+    })));
+    return phases;
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+const char* const kUsage =
+    "usage : bench_graph [--generators=rgg,grid,scalefree] [--edges=1000,10000,...] [--reps=N] [--warmup=N]\n"
+    "                    [--queries=N] [--threads=N] [--dir=D] [--output=F] [--label=L] [--seed=S]";
+
+// Valeur numérique de --option=N (nombre entier, ou réel pour --edges) : tout le texte
+// doit être lu, sinon message d'erreur et usage
+template <class T>
+bool parseNumber(const std::string& text, const std::string& option, T& value) {
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    if (first < last && *first == '+') ++first;
+    std::from_chars_result r = std::from_chars(first, last, value);
+    if (r.ec == std::errc() && r.ptr == last && first != last) return true;
+    std::cerr << "Valeur numérique inconnue : " << text << " (" << option << "N)" << std::endl << kUsage << std::endl;
+    return false;
+}
+
+// Nombre d'arêtes de --edges, en entier ou en notation 1e6
+bool parseEdgeCount(const std::string& text, std::size_t& count) {
+    double value = 0;
+    if (!parseNumber(text, "--edges=", value)) return false;
+    if (!(value >= 1 && value < 1e18) || value != std::floor(value)) {
+        std::cerr << "Nombre d'arêtes invalide : " << text << " (--edges=N,...)" << std::endl << kUsage << std::endl;
+        return false;
+    }
+    count = static_cast<std::size_t>(value);
+    return true;
+}
+
+bool parseOptions(int argc, char* argv[], BenchOptions& opt) {
+    for (int a = 1; a < argc; ++a) {
+        std::string arg = argv[a];
+        if (arg.compare(0, 13, "--generators=") == 0) {
+            opt.generators.clear();
+            for (const std::string& name : splitList(arg.substr(13))) {
+                GeneratorKind kind;
+                if (!parseGeneratorKind(name, kind)) {
+                    std::cerr << "Générateur inconnu : " << name << " (rgg, grid, scalefree)" << std::endl;
+                    return false;
+                }
+                opt.generators.push_back(kind);
+            }
+        } else if (arg.compare(0, 8, "--edges=") == 0) {
+            opt.edges.clear();
+            // 1e6 accepté
+            for (const std::string& size : splitList(arg.substr(8))) {
+                std::size_t count = 0;
+                if (!parseEdgeCount(size, count)) return false;
+                opt.edges.push_back(count);
+            }
+            if (opt.edges.empty()) {
+                std::cerr << "Aucune taille dans " << arg << std::endl << kUsage << std::endl;
+                return false;
+            }
+        } else if (arg.compare(0, 7, "--reps=") == 0) {
+            if (!parseNumber(arg.substr(7), "--reps=", opt.reps)) return false;
+            opt.reps = std::max(1, opt.reps);
+        } else if (arg.compare(0, 9, "--warmup=") == 0) {
+            if (!parseNumber(arg.substr(9), "--warmup=", opt.warmup)) return false;
+            opt.warmup = std::max(0, opt.warmup);
+        } else if (arg.compare(0, 10, "--queries=") == 0) {
+            if (!parseNumber(arg.substr(10), "--queries=", opt.queries)) return false;
+            opt.queries = std::max(1, opt.queries);
+        } else if (arg.compare(0, 10, "--threads=") == 0) {
+            if (!parseNumber(arg.substr(10), "--threads=", opt.threads)) return false;
+        } else if (arg.compare(0, 6, "--dir=") == 0) {
+            opt.dir = arg.substr(6);
+        } else if (arg.compare(0, 9, "--output=") == 0) {
+            opt.output = arg.substr(9);
+        } else if (arg.compare(0, 8, "--label=") == 0) {
+            opt.label = arg.substr(8);
+        } else if (arg.compare(0, 7, "--seed=") == 0) {
+            if (!parseNumber(arg.substr(7), "--seed=", opt.seed)) return false;
+        } else {
+            std::cerr << "Option inconnue : " << arg << std::endl << kUsage << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions opt;
+    if (!parseOptions(argc, argv, opt)) return 1;
+
+    std::error_code error;
+    std::filesystem::create_directories(opt.dir, error);
+
+    // le fichier de résultats est complété d'une exécution à l'autre
+    bool fresh = !std::ifstream(opt.output).good();
+    std::ofstream results(opt.output, std::ios::app);
+    if (!results.is_open()) {
+        std::cerr << "Erreur : Impossible d'ouvrir " << opt.output << std::endl;
+        return 1;
+    }
+    if (fresh) {
+        results << "label;generator;target_edges;nodes;edges;threads;phase;samples;"
+                   "min_ms;p50_ms;p90_ms;p99_ms;max_ms;mean_ms\n";
+    }
+    results << std::fixed << std::setprecision(4);
+
+    for (GeneratorKind kind : opt.generators) {
+        for (std::size_t target : opt.edges) {
+            std::string base = opt.dir + "/" + generatorName(kind) + "_" + std::to_string(target);
+            std::string nodesFile = base + "_nodes.csv", edgesFile = base + "_edges.csv";
+            auto t0 = std::chrono::steady_clock::now();
+            if (!writeSyntheticCsv(generateGraph(kind, target, opt.seed), nodesFile, edgesFile)) {
+                std::cerr << "Erreur : Impossible d'écrire " << nodesFile << " / " << edgesFile << std::endl;
+                return 1;
+            }
+            auto t1 = std::chrono::steady_clock::now();
+
+            GraphInfo info;
+            std::vector<PhaseStats> phases = benchGraph(opt, nodesFile, edgesFile, info);
+            std::cout << generatorName(kind) << " " << target << " : " << info.vertices << " nœuds, " << info.edges
+                      << " arêtes, connexe: " << (info.connected ? "oui" : "non") << ", cycle: "
+                      << (info.cycle ? "oui" : "non") << " (généré en "
+                      << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms)" << std::endl;
+            for (const PhaseStats& s : phases) {
+                std::cout << "    " << std::left << std::setw(16) << s.phase << std::right << std::fixed
+                          << std::setprecision(3) << " p50 " << std::setw(10) << s.p50 << " ms  p90 "
+                          << std::setw(10) << s.p90 << " ms  max " << std::setw(10) << s.max << " ms" << std::endl;
+                std::cout.unsetf(std::ios::floatfield);
+                results << opt.label << ";" << generatorName(kind) << ";" << target << ";" << info.vertices << ";" << info.edges << ";"
+                        << opt.threads << ";" << s.phase << ";" << s.samples << ";" << s.min << ";" << s.p50 << ";"
+                        << s.p90 << ";" << s.p99 << ";" << s.max << ";" << s.mean << "\n";
+            }
+            results.flush();
+        }
+    }
+    std::cout << "Résultats ajoutés à " << opt.output << std::endl;
+    return 0;
+}
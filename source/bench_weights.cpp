@@ -0,0 +1,76 @@
+// Micro-benchmark du calcul en lot des poids (weights_simd.hpp)
+// usage : ./output/bench_weights [nb_noeuds] [nb_aretes] [repetitions]
+// affiche le débit en arêtes/s de chaque noyau disponible et l'écart max avec la version scalaire
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "weights_simd.hpp"
+
+// Mesure le meilleur temps sur `reps` passes (la première sert de chauffe)
+template <class Index>
+double timeKernel(WeightKernel kernel, const std::vector<double>& x, const std::vector<double>& y,
+                  const std::vector<double>& z, const std::vector<Index>& s, const std::vector<Index>& t,
+                  std::vector<double>& w, int reps) {
+    double best = 1e300;
+    for (int r = 0; r <= reps; ++r) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        computeWeightsBatch(x.data(), y.data(), z.data(), s.data(), t.data(), w.data(), w.size(), kernel);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        if (r > 0) best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+template <class Index>
+void runBench(const char* label, std::size_t n, std::size_t m, int reps) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> coord(-1000.0, 1000.0);
+    std::uniform_int_distribution<std::size_t> node(0, n - 1);
+
+    std::vector<double> x(n), y(n), z(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+        z[i] = coord(rng);
+    }
+    std::vector<Index> s(m), t(m);
+    for (std::size_t i = 0; i < m; ++i) {
+        s[i] = static_cast<Index>(node(rng));
+        t[i] = static_cast<Index>(node(rng));
+    }
+
+    std::vector<double> reference(m), w(m);
+    computeWeightsBatch(x.data(), y.data(), z.data(), s.data(), t.data(), reference.data(), m, WeightKernel::Scalar);
+
+    std::cout << "indices " << label << " (" << n << " nœuds, " << m << " arêtes)" << std::endl;
+    const WeightKernel kernels[] = { WeightKernel::Scalar, WeightKernel::Avx2, WeightKernel::Avx512 };
+    for (WeightKernel k : kernels) {
+        if (!weightKernelSupported(k)) {
+            std::cout << "  " << weightKernelName(k) << " : non supporté par ce CPU" << std::endl;
+            continue;
+        }
+        double seconds = timeKernel(k, x, y, z, s, t, w, reps);
+        double maxDiff = 0.0;
+        for (std::size_t i = 0; i < m; ++i) maxDiff = std::max(maxDiff, std::fabs(w[i] - reference[i]));
+        std::cout << "  " << weightKernelName(k) << " : " << seconds * 1000.0 << " ms, "
+                  << m / seconds / 1e6 << " M arêtes/s, écart max " << maxDiff << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    std::size_t m = argc > 2 ? std::stoull(argv[2]) : 8000000;
+    int reps = argc > 3 ? std::stoi(argv[3]) : 5;
+    if (n == 0) n = 1;
+
+    std::cout << "Noyau sélectionné : " << weightKernelName(bestWeightKernel()) << std::endl;
+    runBench<std::int32_t>("32 bits", n, m, reps);
+    runBench<std::size_t>("64 bits", n, m, reps);
+    return 0;
+}
@@ -0,0 +1,164 @@
+#ifndef BUFFERED_WRITER_HPP
+#define BUFFERED_WRITER_HPP
+
+// Écriture de fichiers par gros blocs : le texte est formaté directement dans un
+// tampon (std::to_chars pour les nombres, pas d'iostream ni de flush par ligne)
+// puis écrit en un seul appel write() par bloc de 1 Mo.
+// Dès que la sortie dépasse un bloc, les blocs pleins sont confiés à un thread
+// d'écriture et le formatage continue dans un autre tampon (les petits fichiers
+// n'ont jamais de thread) ; background = false garde tout dans le thread appelant.
+
+#include <cerrno>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+class BufferedWriter {
+public:
+    static constexpr std::size_t kBlockSize = std::size_t(1) << 20;
+
+    explicit BufferedWriter(const std::string& filename, bool background = true)
+        : _fd(::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666)), _background(background) {
+        _block.reserve(kBlockSize + 256);
+    }
+    ~BufferedWriter() { close(); }
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    bool is_open() const { return _fd >= 0; }
+    std::uint64_t bytesWritten() const { return _bytes; }
+
+    void put(char c) {
+        _block.push_back(c);
+        ++_bytes;
+        if (_block.size() >= kBlockSize) flushBlock();
+    }
+    void write(const char* text, std::size_t size) {
+        _block.append(text, size);
+        _bytes += size;
+        if (_block.size() >= kBlockSize) flushBlock();
+    }
+    void write(const std::string& text) { write(text.data(), text.size()); }
+    template <std::size_t N>
+    void write(const char (&text)[N]) { write(text, N - 1); }
+
+    // Entier en décimal (même texte que operator<<)
+    template <class Int>
+    void writeInt(Int value) {
+        char digits[24];
+        std::to_chars_result r = std::to_chars(digits, digits + sizeof digits, value);
+        write(digits, static_cast<std::size_t>(r.ptr - digits));
+    }
+
+    // Réel en notation fixe (même texte que std::fixed << std::setprecision(precision))
+    void writeFixed(double value, int precision) {
+        char digits[352];
+        std::to_chars_result r = std::to_chars(digits, digits + sizeof digits, value, std::chars_format::fixed, precision);
+        write(digits, static_cast<std::size_t>(r.ptr - digits));
+    }
+
+    // Réel avec precision chiffres significatifs (même texte que operator<< par défaut)
+    void writeGeneral(double value, int precision = 6) {
+        char digits[32];
+        std::to_chars_result r = std::to_chars(digits, digits + sizeof digits, value, std::chars_format::general, precision);
+        write(digits, static_cast<std::size_t>(r.ptr - digits));
+    }
+
+    // Vide les tampons et ferme le fichier ; faux si une écriture a échoué
+    bool close() {
+        if (_fd < 0) return _ok;
+        flushBlock();
+        if (_thread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _closing = true;
+            }
+            _ready.notify_all();
+            _thread.join();
+        }
+        if (::close(_fd) != 0) _ok = false;
+        _fd = -1;
+        return _ok;
+    }
+
+private:
+    void flushBlock() {
+        if (_block.empty()) return;
+        if (!_background) {
+            writeAll(_block);
+            _block.clear();
+            return;
+        }
+        if (!_thread.joinable()) _thread = std::thread([this]() { writerLoop(); });
+        std::string next;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            // au plus deux blocs en attente : le formatage ne prend pas d'avance illimitée sur le disque
+            _done.wait(lock, [this]() { return _pending.size() < 2; });
+            _pending.push_back(std::move(_block));
+            if (!_spare.empty()) {
+                next = std::move(_spare.back());
+                _spare.pop_back();
+            }
+        }
+        _ready.notify_one();
+        next.clear();
+        next.reserve(kBlockSize + 256);
+        _block = std::move(next);
+    }
+
+    void writerLoop() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (;;) {
+            _ready.wait(lock, [this]() { return !_pending.empty() || _closing; });
+            if (_pending.empty()) return;
+            std::string block = std::move(_pending.front());
+            _pending.pop_front();
+            lock.unlock();
+            bool ok = writeAll(block);
+            block.clear();
+            lock.lock();
+            if (!ok) _ok = false;
+            _spare.push_back(std::move(block));
+            _done.notify_one();
+        }
+    }
+
+    bool writeAll(const std::string& block) {
+        std::size_t done = 0;
+        while (done < block.size()) {
+            ssize_t n = ::write(_fd, block.data() + done, block.size() - done);
+            if (n < 0 && errno == EINTR) continue;  // interrompu par un signal : on réessaie
+            if (n <= 0) {
+                _ok = false;
+                return false;
+            }
+            done += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    int _fd;
+    bool _background;
+    bool _ok = true;
+    std::uint64_t _bytes = 0;
+    std::string _block;                   // bloc en cours de formatage
+
+    std::thread _thread;                  // écriture en arrière-plan (démarrée au premier bloc plein)
+    std::mutex _mutex;
+    std::condition_variable _ready, _done;
+    std::deque<std::string> _pending;     // blocs pleins à écrire, dans l'ordre
+    std::vector<std::string> _spare;      // tampons déjà écrits, réutilisés
+    bool _closing = false;
+};
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef CENTRALITY_HPP
+#define CENTRALITY_HPP
+
+// Centralités pour repérer les nœuds carrefours (--centrality) : intermédiarité
+// (betweenness, algorithme de Brandes sur les poids des arêtes) et proximité (closeness).
+// Un Dijkstra par source, réparti sur les threads (prochaine source libre) ; chaque
+// thread a son espace de travail et ses accumulateurs, additionnés à la fin.
+// - exact : toutes les sources, O(n m log n)
+// - échantillonné (samples = k < n) : k sources tirées au hasard (graine fixe, résultat
+//   reproductible), contributions multipliées par n / k (Brandes et Pich) ; la proximité
+//   de chaque nœud est estimée par ses distances aux k sources (Eppstein et Wang)
+// Pas de listes de prédécesseurs : une arête u -> v est sur un plus court chemin si
+// d(u) + w = d(v), les sommets sont parcourus dans l'ordre où Dijkstra les a fixés
+// (comptage des chemins) puis dans l'ordre inverse (dépendances). Boucles ignorées,
+// poids > 0 supposés sur les autres arêtes ;
+// les plus courts chemins ex aequo se partagent la dépendance.
+// Intermédiarité non normalisée (paires non ordonnées en non orienté, comme Boost).
+// Proximité de Wasserman-Faust, définie aussi sur un graphe non connexe :
+// (r / somme des distances) x (r / (n - 1)), r = nœuds atteints ; en orienté, distances
+// depuis les autres nœuds (proximité entrante).
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include "buffered_writer.hpp"
+#include "graph_types.hpp"
+#include "metrics.hpp"
+
+struct CentralityOptions {
+    bool enabled = false;      // --centrality[=K]
+    std::size_t samples = 0;   // K sources tirées au hasard, 0 = toutes (exact)
+    std::uint64_t seed = 1;    // --centrality-seed
+};
+
+struct CentralityResult {
+    std::vector<double> betweenness;
+    std::vector<double> closeness;
+    std::size_t sources = 0;   // nombre de Dijkstra
+    bool exact = true;
+};
+
+namespace centrality_detail {
+
+// Espace de travail d'un thread : tableaux du parcours (remis à zéro par époque)
+// et accumulateurs sur toutes les sources traitées par ce thread
+template <class G>
+class BrandesWorkspace {
+public:
+    typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+
+    explicit BrandesWorkspace(std::size_t n)
+        : betweenness(n, 0.0), distanceSum(n, 0.0), reachedBy(n, 0),
+          _dist(n), _sigma(n), _delta(n), _reached(n, 0), _settled(n, 0) {
+        _order.reserve(n);
+    }
+
+    // Dijkstra depuis s puis accumulation des dépendances de s
+    void run(const G& g, Vertex s) {
+        if (++_epoch == 0) {
+            std::fill(_reached.begin(), _reached.end(), 0);
+            std::fill(_settled.begin(), _settled.end(), 0);
+            _epoch = 1;
+        }
+        auto weights = get(&EdgeInfo::weight, g);
+        typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+
+        std::uint64_t pushes = 1, pops = 0;
+        _order.clear();
+        _heap.clear();
+        _reached[s] = _epoch;
+        _dist[s] = 0.0;
+        _heap.push_back(HeapEntry(0.0, s));
+        while (!_heap.empty()) {
+            std::pop_heap(_heap.begin(), _heap.end(), std::greater<HeapEntry>());
+            HeapEntry top = _heap.back();
+            _heap.pop_back();
+            ++pops;
+            Vertex u = top.second;
+            if (_settled[u] == _epoch) continue;
+            _settled[u] = _epoch;
+            _order.push_back(u);
+            for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+                Vertex v = target(*ei, g);
+                double d = top.first + get(weights, *ei);
+                if (_reached[v] != _epoch || d < _dist[v]) {
+                    _reached[v] = _epoch;
+                    _dist[v] = d;
+                    _heap.push_back(HeapEntry(d, v));
+                    std::push_heap(_heap.begin(), _heap.end(), std::greater<HeapEntry>());
+                    ++pushes;
+                }
+            }
+        }
+
+        // nombre de plus courts chemins depuis s, dans l'ordre croissant des distances
+        for (Vertex u : _order) _sigma[u] = 0.0;
+        _sigma[s] = 1.0;
+        for (Vertex u : _order) {
+            for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+                Vertex v = target(*ei, g);
+                if (v != u && _dist[u] + get(weights, *ei) == _dist[v]) _sigma[v] += _sigma[u];
+            }
+        }
+        // dépendances, des plus lointains vers s
+        for (auto it = _order.rbegin(); it != _order.rend(); ++it) {
+            Vertex u = *it;
+            double delta = 0.0;
+            for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+                Vertex v = target(*ei, g);
+                if (v != u && _dist[u] + get(weights, *ei) == _dist[v]) delta += _sigma[u] / _sigma[v] * (1.0 + _delta[v]);
+            }
+            _delta[u] = delta;
+            if (u == s) continue;
+            betweenness[u] += delta;
+            distanceSum[u] += _dist[u];
+            ++reachedBy[u];
+        }
+        if (Metrics::enabled()) {
+            Metrics::add(Counter::VerticesSettled, _order.size());
+            Metrics::add(Counter::HeapPushes, pushes);
+            Metrics::add(Counter::HeapPops, pops);
+        }
+    }
+
+    std::vector<double> betweenness;        // somme des dépendances
+    std::vector<double> distanceSum;        // somme des distances depuis les sources
+    std::vector<std::uint32_t> reachedBy;   // nombre de sources qui atteignent le nœud
+
+private:
+    typedef std::pair<double, Vertex> HeapEntry;
+
+    std::vector<double> _dist;
+    std::vector<double> _sigma;
+    std::vector<double> _delta;
+    std::vector<unsigned> _reached;
+    std::vector<unsigned> _settled;
+    std::vector<Vertex> _order;       // sommets dans l'ordre où ils sont fixés
+    std::vector<HeapEntry> _heap;
+    unsigned _epoch = 0;
+};
+
+} // namespace centrality_detail
+
+// Sources du calcul : toutes (exact) ou un échantillon sans remise de samples sommets
+inline std::vector<std::size_t> centralitySources(std::size_t n, const CentralityOptions& options) {
+    std::vector<std::size_t> sources(n);
+    std::iota(sources.begin(), sources.end(), std::size_t(0));
+    if (options.samples == 0 || options.samples >= n) return sources;
+    std::mt19937_64 random(options.seed);
+    for (std::size_t i = 0; i < options.samples; ++i) {
+        std::uniform_int_distribution<std::size_t> pick(i, n - 1);
+        std::swap(sources[i], sources[pick(random)]);
+    }
+    sources.resize(options.samples);
+    std::sort(sources.begin(), sources.end());
+    return sources;
+}
+
+// threads = 0 : tous les coeurs
+template <class G>
+CentralityResult computeCentrality(const G& g, const CentralityOptions& options, unsigned threads = 1) {
+    ScopedPhase phase(Phase::Centrality);
+    typedef centrality_detail::BrandesWorkspace<G> Workspace;
+    const std::size_t n = num_vertices(g);
+    const bool directed = boost::is_directed_graph<G>::value;
+    const std::vector<std::size_t> sources = centralitySources(n, options);
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, sources.size())));
+    std::vector<std::unique_ptr<Workspace>> workspaces(threads);
+    std::atomic<std::size_t> next(0);
+    auto worker = [&](unsigned t) {
+        workspaces[t].reset(new Workspace(n));
+        for (std::size_t k = next++; k < sources.size(); k = next++) workspaces[t]->run(g, sources[k]);
+    };
+    if (threads <= 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+        for (auto& th : pool) th.join();
+    }
+
+    CentralityResult result;
+    result.sources = sources.size();
+    result.exact = sources.size() == n;
+    result.betweenness.assign(n, 0.0);
+    result.closeness.assign(n, 0.0);
+    std::vector<char> isSource(n, 0);
+    for (std::size_t s : sources) isSource[s] = 1;
+    // en non orienté chaque paire est comptée depuis ses deux extrémités
+    const double scale = (sources.empty() ? 0.0 : double(n) / sources.size()) / (directed ? 1.0 : 2.0);
+    for (std::size_t v = 0; v < n; ++v) {
+        double dependency = 0.0, distance = 0.0;
+        std::size_t reached = 0;
+        for (const auto& ws : workspaces) {
+            dependency += ws->betweenness[v];
+            distance += ws->distanceSum[v];
+            reached += ws->reachedBy[v];
+        }
+        result.betweenness[v] = dependency * scale;
+        const std::size_t others = sources.size() - isSource[v];  // sources autres que v
+        if (reached > 0 && distance > 0) result.closeness[v] = (reached / distance) * (double(reached) / others);
+    }
+    return result;
+}
+
+// Les count nœuds de plus grande valeur, par valeur décroissante (indice croissant à égalité)
+inline std::vector<std::size_t> topVertices(const std::vector<double>& values, std::size_t count) {
+    std::vector<std::size_t> order(values.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    count = std::min(count, order.size());
+    std::partial_sort(order.begin(), order.begin() + count, order.end(), [&values](std::size_t a, std::size_t b) {
+        return values[a] > values[b] || (values[a] == values[b] && a < b);
+    });
+    order.resize(count);
+    return order;
+}
+
+// centrality.csv : degré de chaque nœud (sortant en orienté) et, avec --centrality, son
+// intermédiarité et sa proximité ; remplace l'affichage d'une ligne par nœud du rapport
+template <class G>
+void writeCentralityToCSV(const G& g, const std::vector<std::size_t>& degree, const CentralityResult* centrality,
+                          const std::string& filename) {
+    ScopedPhase phase(Phase::WriteCsv);
+    BufferedWriter csvFile(filename);
+    if (!csvFile.is_open()) {
+        std::cerr << "Erreur : Impossible de créer le fichier CSV." << std::endl;
+        return;
+    }
+    csvFile.write(centrality ? "NodeID;Degree;Betweenness;Closeness\n" : "NodeID;Degree\n");
+    auto ids = get(&NodeInfo::id, g);
+    for (std::size_t v = 0; v < degree.size(); ++v) {
+        csvFile.writeInt(get(ids, v));
+        csvFile.put(';');
+        csvFile.writeInt(degree[v]);
+        if (centrality) {
+            csvFile.put(';');
+            csvFile.writeGeneral(centrality->betweenness[v]);
+            csvFile.put(';');
+            csvFile.writeGeneral(centrality->closeness[v]);
+        }
+        csvFile.put('\n');
+    }
+    if (!csvFile.close()) std::cerr << "Erreur : Écriture incomplète de " << filename << std::endl;
+    Metrics::add(Counter::BytesWritten, csvFile.bytesWritten());
+    std::cout << "Fichier CSV généré : " << filename << std::endl;
+}
+
+// centrality.csv est rangé dans le même dossier que paths.csv
+inline std::string centralityFileFor(const std::string& pathsFile) {
+    std::size_t slash = pathsFile.find_last_of('/');
+    return (slash == std::string::npos ? std::string() : pathsFile.substr(0, slash + 1)) + "centrality.csv";
+}
+
+#endif
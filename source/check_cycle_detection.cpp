@@ -0,0 +1,101 @@
+// Vérification de la détection de cycle (cycle_detection.hpp) sur de petits graphes construits
+// à la main : make check (lancée aussi par make)
+// pour chaque graphe, sur l'adjacency_list puis sur le CSR figé : hasCycle (avec et sans les
+// composantes), hasCycleByCount (non orienté) et findCycle, dont le témoin doit être un vrai
+// cycle (sommets distincts, chacun relié au suivant, le dernier relié au premier)
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "graph_types.hpp"
+#include "graph_config.hpp"
+#include "csr_graph.hpp"
+#include "connected_components.hpp"
+#include "graph_algorithms.hpp"
+
+static int checks = 0;
+static int failures = 0;
+
+void expect(bool ok, const std::string& what) {
+    ++checks;
+    if (ok) return;
+    ++failures;
+    std::cerr << "Échec : " << what << std::endl;
+}
+
+// Nombre d'arêtes a -> b (a - b en non orienté)
+template <class G>
+std::size_t edgeCount(const G& g, std::size_t a, std::size_t b) {
+    std::size_t count = 0;
+    typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = out_edges(a, g); ei != ei_end; ++ei) {
+        if (static_cast<std::size_t>(target(*ei, g)) == b) ++count;
+    }
+    return count;
+}
+
+// v0 -> v1 -> ... -> vk -> v0 ; en non orienté, un cycle de deux sommets demande deux arêtes parallèles
+template <class G, class Vertex>
+bool isCycle(const G& g, const std::vector<Vertex>& cycle) {
+    const bool directed = boost::is_directed_graph<G>::value;
+    std::vector<char> seen(num_vertices(g), 0);
+    for (std::size_t i = 0; i < cycle.size(); ++i) {
+        std::size_t a = cycle[i], b = cycle[(i + 1) % cycle.size()];
+        if (seen[a]++) return false;
+        if (edgeCount(g, a, b) == 0) return false;
+    }
+    if (!directed && cycle.size() == 2 && edgeCount(g, cycle[0], cycle[1]) < 2) return false;
+    return !cycle.empty();
+}
+
+template <class G>
+void checkGraph(const G& g, const std::string& name, bool expected) {
+    const bool directed = boost::is_directed_graph<G>::value;
+    ComponentLabels components = connectedComponentLabels(g);
+    expect(hasCycle(g) == expected, name + " : hasCycle");
+    expect(hasCycle(g, &components) == expected, name + " : hasCycle avec les composantes");
+    if (!directed) expect(hasCycleByCount(g, components) == expected, name + " : hasCycleByCount");
+    auto cycle = findCycle(g);
+    expect(cycle.empty() != expected, name + " : findCycle");
+    if (!cycle.empty()) expect(isCycle(g, cycle), name + " : témoin de findCycle");
+}
+
+template <class D>
+void check(const std::string& name, std::size_t n, const std::vector<std::pair<std::size_t, std::size_t>>& edges,
+           bool expected) {
+    typedef typename boost::graph_traits<BasicGraph<D>>::directed_category Directed;
+    BasicGraph<D> g;
+    for (std::size_t i = 0; i < n; ++i) add_vertex(NodeInfo{ NodeId(i + 1), 0.0, 0.0, 0.0 }, g);
+    for (const auto& e : edges) add_edge(e.first, e.second, EdgeInfo{ 1.0, false }, g);
+    rebuildNodeIdMap(g);
+    checkGraph(g, name, expected);
+    checkGraph(BasicCsrGraph<GraphConfig<Directed, double, std::uint32_t>>(g), name + " (CSR)", expected);
+}
+
+int main() {
+    // arbre : 0 - 1, 0 - 2, 1 - 3, 1 - 4, 2 - 5 ; plus un sommet isolé (deux composantes)
+    const std::vector<std::pair<std::size_t, std::size_t>> tree = { { 0, 1 }, { 0, 2 }, { 1, 3 }, { 1, 4 }, { 2, 5 } };
+    check<boost::undirectedS>("arbre", 7, tree, false);
+    auto parallel = tree;
+    parallel.push_back(std::make_pair(3, 1));
+    check<boost::undirectedS>("arbre + arête parallèle", 7, parallel, true);
+    auto loop = tree;
+    loop.push_back(std::make_pair(5, 5));
+    check<boost::undirectedS>("arbre + boucle", 7, loop, true);
+    check<boost::undirectedS>("triangle", 3, { { 0, 1 }, { 1, 2 }, { 2, 0 } }, true);
+    auto triangle = tree;
+    triangle.push_back(std::make_pair(4, 3));
+    check<boost::undirectedS>("arbre + triangle", 7, triangle, true);
+
+    // DAG : E = 6 > V - C = 3 (sommet 4 isolé), sans cycle orienté
+    check<boost::directedS>("DAG", 5, { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 1, 3 }, { 2, 3 }, { 0, 3 } }, false);
+    check<boost::directedS>("u -> v -> u", 2, { { 0, 1 }, { 1, 0 } }, true);
+    check<boost::directedS>("boucle orientée", 3, { { 0, 1 }, { 1, 1 } }, true);
+    check<boost::directedS>("DAG + arc arrière", 5, { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 1, 3 }, { 2, 3 }, { 3, 0 } }, true);
+
+    std::cout << "Détection de cycle : " << checks << " vérifications, " << failures << " échec(s)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,335 @@
+// Vérification des versions parallèles contre leur référence séquentielle, sur des graphes
+// synthétiques (graph_generators.hpp) : make check (lancée aussi par make)
+// - delta-stepping (delta_stepping.hpp) avec 1 à 4 threads et plusieurs largeurs de seaux,
+//   contre Dijkstra (dijkstra_workspace.hpp) : mêmes sommets atteints, mêmes distances au
+//   bit près, prédécesseurs formant un arbre de plus courts chemins ; non orienté, orienté
+//   et CSR figé
+// - chargement parallèle de edges.csv (loadEdgesParallel, 2 à 8 threads) contre le
+//   chargement séquentiel : mêmes arêtes, dans le même ordre, mêmes poids, sur un fichier
+//   parsemé de lignes invalides (IDs hors du graphe, champs manquants ou non numériques),
+//   avec des IDs consécutifs ou quelconques
+// - écriture par blocs (buffered_writer.hpp) de paths.csv et du DOT, octet pour octet
+//   contre l'ancienne écriture std::ofstream et boost::write_graphviz, sur plusieurs blocs
+//   (thread d'écriture) et avec des longueurs à arrondir au demi-centième
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "graph_types.hpp"
+#include "graph_config.hpp"
+#include "csr_graph.hpp"
+#include "graph_generators.hpp"
+#include "graph_io.hpp"
+#include "dijkstra_workspace.hpp"
+#include "delta_stepping.hpp"
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // edge_iterator orienté de Boost, voir graph_types.hpp
+#include <boost/graph/graphviz.hpp>
+#pragma GCC diagnostic pop
+
+static int checks = 0;
+static int failures = 0;
+
+void expect(bool ok, const std::string& what) {
+    ++checks;
+    if (ok) return;
+    ++failures;
+    std::cerr << "Échec : " << what << std::endl;
+}
+
+// Graphe synthétique chargé en mémoire, poids calculés comme au chargement des CSV
+template <class D>
+void buildGraph(BasicGraph<D>& g, const SyntheticGraph& synthetic) {
+    assignNodes(g, synthetic.nodes);
+    EdgeBatch batch = synthetic.edges;
+    computeEdgeWeights(nodeCoordsOf(g), batch);
+    insertEdgeBatch(g, batch);
+}
+
+// p -> v existe et d(p) + w = d(v)
+template <class G, class Workspace>
+bool treeEdge(const G& g, const Workspace& ws, std::size_t p, std::size_t v) {
+    auto weights = get(&EdgeInfo::weight, g);
+    typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = out_edges(p, g); ei != ei_end; ++ei) {
+        if (static_cast<std::size_t>(target(*ei, g)) == v && ws.distance(p) + get(weights, *ei) == ws.distance(v)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class G>
+void checkDeltaStepping(const G& g, const std::string& name) {
+    typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+    const std::size_t n = num_vertices(g);
+    DijkstraWorkspace<G> reference(n);
+    DeltaSteppingWorkspace<G> parallel(n);
+    const std::vector<Vertex> noTarget;
+    const double width = deltaSteppingWidth(g);
+    for (std::size_t source : { std::size_t(0), n / 2, n - 1 }) {
+        reference.run(g, static_cast<Vertex>(source), noTarget);
+        std::vector<Vertex> targets = { static_cast<Vertex>(n / 3), static_cast<Vertex>(n - 2) };
+        for (double delta : { width, width / 20, width * 50 }) {
+            for (unsigned threads = 1; threads <= 4; ++threads) {
+                const std::string run = name + " : source " + std::to_string(source) + ", delta " +
+                                        std::to_string(delta) + ", " + std::to_string(threads) + " thread(s)";
+                parallel.run(g, static_cast<Vertex>(source), noTarget, threads, delta);
+                std::size_t wrongReach = 0, wrongDistance = 0, wrongTree = 0;
+                for (std::size_t v = 0; v < n; ++v) {
+                    Vertex u = static_cast<Vertex>(v);
+                    if (parallel.reached(u) != reference.reached(u)) ++wrongReach;
+                    else if (!reference.reached(u)) continue;
+                    else if (parallel.distance(u) != reference.distance(u)) ++wrongDistance;
+                    else if (v != source && !treeEdge(g, parallel, parallel.predecessor(u), v)) ++wrongTree;
+                }
+                expect(wrongReach == 0, run + " : " + std::to_string(wrongReach) + " sommet(s) atteints à tort");
+                expect(wrongDistance == 0, run + " : " + std::to_string(wrongDistance) + " distance(s) différentes");
+                expect(wrongTree == 0, run + " : " + std::to_string(wrongTree) + " prédécesseur(s) invalides");
+
+                // arrêt sur les cibles : leurs distances sont déjà définitives
+                parallel.run(g, static_cast<Vertex>(source), targets, threads, delta);
+                for (Vertex t : targets) {
+                    expect(parallel.reached(t) == reference.reached(t) &&
+                           (!reference.reached(t) || parallel.distance(t) == reference.distance(t)),
+                           run + " : distance de la cible " + std::to_string(t));
+                }
+            }
+        }
+    }
+}
+
+// Les chargements affichent leur débit sur std::cout : sortie coupée pendant la vérification
+class QuietOutput {
+public:
+    QuietOutput() : _saved(std::cout.rdbuf(_sink.rdbuf())) {}
+    ~QuietOutput() { std::cout.rdbuf(_saved); }
+private:
+    std::ostringstream _sink;
+    std::streambuf* _saved;
+};
+
+// nodes.csv et edges.csv du graphe synthétique, IDs = indice * stride + first, avec une
+// ligne invalide toutes les 37 arêtes (fins de ligne \r\n par endroits, pas de fin de
+// ligne à la dernière)
+void writeCsvWithInvalidRows(const SyntheticGraph& synthetic, NodeId first, NodeId stride,
+                             const std::string& nodesFile, const std::string& edgesFile) {
+    const NodeId n = static_cast<NodeId>(synthetic.nodes.size());
+    auto id = [first, stride](NodeId index) { return first + index * stride; };
+    std::ofstream nodes(nodesFile, std::ios::binary);
+    nodes << "Nodeid;x;y;z\n";
+    for (NodeId v = 0; v < n; ++v) {
+        const NodeInfo& node = synthetic.nodes[v];
+        nodes << id(v) << ";" << node.x << ";" << node.y << ";" << node.z << "\n";
+    }
+    const std::vector<std::string> invalid = {
+        std::to_string(id(n)) + ";" + std::to_string(id(0)),        // source après le dernier nœud
+        std::to_string(id(1)) + ";" + std::to_string(first - 1),    // cible avant le premier
+        stride > 1 ? std::to_string(id(2)) + ";" + std::to_string(id(1) + 1)   // entre deux IDs
+                   : "0;" + std::to_string(id(1)),
+        "-3;" + std::to_string(id(0)),
+        std::to_string(id(0)) + ";abc",
+        std::to_string(id(0)),
+        "",
+        "x;y",
+    };
+    std::ofstream edges(edgesFile, std::ios::binary);
+    edges << "Source Node ID;Target Node ID\n";
+    const std::size_t m = synthetic.edges.size();
+    for (std::size_t i = 0; i < m; ++i) {
+        if (i % 37 == 0) edges << invalid[(i / 37) % invalid.size()] << "\n";
+        edges << id(synthetic.edges.source[i]) << ";" << id(synthetic.edges.target[i]);
+        if (i + 1 < m) edges << (i % 5 == 0 ? "\r\n" : "\n");
+    }
+}
+
+// Arêtes dans l'ordre de edges(g) puis de out_edges de chaque sommet, avec leur poids
+template <class D>
+bool sameGraph(const BasicGraph<D>& a, const BasicGraph<D>& b) {
+    if (num_vertices(a) != num_vertices(b) || num_edges(a) != num_edges(b)) return false;
+    auto ea = edges(a), eb = edges(b);
+    for (; ea.first != ea.second; ++ea.first, ++eb.first) {
+        if (source(*ea.first, a) != source(*eb.first, b) || target(*ea.first, a) != target(*eb.first, b) ||
+            std::memcmp(&a[*ea.first].weight, &b[*eb.first].weight, sizeof(double)) != 0) {
+            return false;
+        }
+    }
+    for (std::size_t v = 0; v < num_vertices(a); ++v) {
+        auto oa = out_edges(v, a), ob = out_edges(v, b);
+        if (out_degree(v, a) != out_degree(v, b)) return false;
+        for (; oa.first != oa.second; ++oa.first, ++ob.first) {
+            if (target(*oa.first, a) != target(*ob.first, b) || a[*oa.first].weight != b[*ob.first].weight) return false;
+        }
+    }
+    return true;
+}
+
+template <class D>
+void checkParallelLoad(const std::string& nodesFile, const std::string& edgesFile, std::size_t expectedEdges,
+                       const std::string& name) {
+    BasicGraph<D> serial;
+    {
+        QuietOutput quiet;
+        loadCsvGraph(serial, nodesFile, edgesFile, 1);
+    }
+    expect(num_edges(serial) == expectedEdges, name + " : " + std::to_string(num_edges(serial)) +
+           " arêtes chargées en séquentiel au lieu de " + std::to_string(expectedEdges));
+    for (unsigned threads : { 2u, 3u, 4u, 8u }) {
+        BasicGraph<D> parallel;
+        {
+            QuietOutput quiet;
+            loadCsvGraph(parallel, nodesFile, edgesFile, threads);
+        }
+        expect(sameGraph(serial, parallel), name + " : chargement sur " + std::to_string(threads) +
+               " threads différent du chargement séquentiel");
+    }
+}
+
+void checkLoaders(const std::string& dir) {
+    const std::string nodesFile = dir + "/nodes.csv", edgesFile = dir + "/edges.csv";
+    for (GeneratorKind kind : { GeneratorKind::Geometric, GeneratorKind::ScaleFree }) {
+        const SyntheticGraph synthetic = generateGraph(kind, 20000, 11);
+        const std::string name = std::string("chargement ") + generatorName(kind);
+        writeCsvWithInvalidRows(synthetic, 1, 1, nodesFile, edgesFile);
+        checkParallelLoad<boost::undirectedS>(nodesFile, edgesFile, synthetic.edges.size(), name);
+        checkParallelLoad<boost::directedS>(nodesFile, edgesFile, synthetic.edges.size(), name + " (orienté)");
+        writeCsvWithInvalidRows(synthetic, 5000000000LL, 3, nodesFile, edgesFile);
+        checkParallelLoad<boost::undirectedS>(nodesFile, edgesFile, synthetic.edges.size(), name + " (IDs espacés)");
+    }
+    // moins de lignes que de threads
+    SyntheticGraph tiny = generateGraph(GeneratorKind::Grid, 3, 11);
+    writeCsvWithInvalidRows(tiny, 1, 1, nodesFile, edgesFile);
+    checkParallelLoad<boost::undirectedS>(nodesFile, edgesFile, tiny.edges.size(), "chargement minuscule");
+}
+
+std::string fileContents(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// paths.csv tel que l'écrivait generatePathsCSV avant BufferedWriter
+void writePathsReference(const std::vector<NodePair>& nodePairs, const std::vector<PathResult>& results,
+                         const std::string& filename) {
+    std::ofstream csvFile(filename);
+    csvFile << "SourceNodeID;TargetNodeID;PathLength;Path" << std::endl;
+    for (size_t p = 0; p < nodePairs.size(); ++p) {
+        const auto& path = results[p].second;
+        csvFile << nodePairs[p].first << ";" << nodePairs[p].second << ";" << std::fixed << std::setprecision(2)
+                << results[p].first << ";";
+        if (path.empty()) {
+            csvFile << "No path";
+        } else {
+            for (size_t i = 0; i < path.size(); ++i) {
+                csvFile << path[i];
+                if (i < path.size() - 1) csvFile << "->";
+            }
+        }
+        csvFile << std::endl;
+    }
+}
+
+// DOT tel que l'écrivait generateGraphImage avant writeGraphDot
+template <class D>
+void writeDotReference(const BasicGraph<D>& g, const std::string& filename) {
+    typedef typename boost::graph_traits<BasicGraph<D>>::vertex_descriptor Vertex;
+    typedef typename boost::graph_traits<BasicGraph<D>>::edge_descriptor Edge;
+    std::ofstream dotFile(filename);
+    auto vertex_writer = [&g](std::ostream& out, const Vertex& v) {
+        out << "[label=\"" << g[v].id << "\"]";
+    };
+    auto edge_writer = [&g](std::ostream& out, const Edge& e) {
+        out << "[label=\"" << std::fixed << std::setprecision(2) << g[e].weight << "\"";
+        if (g[e].inPath) {
+            out << ", color=red, penwidth=2";
+        }
+        out << "]";
+    };
+    boost::write_graphviz(dotFile, g, vertex_writer, edge_writer);
+}
+
+void checkPathsWriter(const std::string& dir) {
+    const std::string written = dir + "/paths.csv", reference = dir + "/paths_reference.csv";
+    std::mt19937_64 random(5);
+    // demi-centièmes (arrondis différemment selon la représentation binaire), négatifs, grands
+    const std::vector<double> lengths = { -1, 0, -0.0, -0.004, 0.005, 0.015, 0.125, 1.005, 2.675, 999.995,
+                                          123456.785, 1e15 + 0.5, 1e300, 5e-324 };
+    std::uniform_real_distribution<double> length(0, 50000);
+    std::vector<NodePair> nodePairs;
+    std::vector<PathResult> results;
+    for (std::size_t p = 0; p < 40000; ++p) {
+        const NodeId source = static_cast<NodeId>(random() % 10000000000ULL), target = static_cast<NodeId>(random() % 1000);
+        nodePairs.push_back(NodePair(source, target));
+        PathResult result(p < lengths.size() ? lengths[p] : length(random), {});
+        if (p % 7 != 3) {
+            const std::size_t hops = random() % 40;
+            for (std::size_t i = 0; i <= hops; ++i) result.second.push_back(static_cast<NodeId>(random() % 100000000));
+        }
+        results.push_back(result);
+    }
+    {
+        QuietOutput quiet;
+        writePathResultsToCSV(nodePairs, results, written);
+    }
+    writePathsReference(nodePairs, results, reference);
+    const std::string a = fileContents(written), b = fileContents(reference);
+    expect(a.size() > 2 * BufferedWriter::kBlockSize, "paths.csv : fichier trop petit pour passer par le thread d'écriture");
+    expect(a == b, "paths.csv : " + std::to_string(a.size()) + " octets différents de l'écriture std::ofstream (" +
+           std::to_string(b.size()) + " octets)");
+}
+
+template <class D>
+void checkDotWriter(const SyntheticGraph& synthetic, const std::string& dir, const std::string& name) {
+    const std::string written = dir + "/graph.dot", reference = dir + "/graph_reference.dot";
+    BasicGraph<D> g;
+    buildGraph(g, synthetic);
+    std::size_t i = 0;
+    typename boost::graph_traits<BasicGraph<D>>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = edges(g); ei != ei_end; ++ei, ++i) g[*ei].inPath = i % 11 == 0;
+    expect(writeGraphDot(g, written), name + " : écriture du DOT");
+    writeDotReference(g, reference);
+    const std::string a = fileContents(written), b = fileContents(reference);
+    expect(a.size() > BufferedWriter::kBlockSize, name + " : DOT trop petit pour passer par le thread d'écriture");
+    expect(a == b, name + " : DOT de " + std::to_string(a.size()) + " octets différent de boost::write_graphviz (" +
+           std::to_string(b.size()) + " octets)");
+}
+
+void checkWriters(const std::string& dir) {
+    checkPathsWriter(dir);
+    const SyntheticGraph synthetic = generateGraph(GeneratorKind::ScaleFree, 60000, 13);
+    checkDotWriter<boost::undirectedS>(synthetic, dir, "DOT scalefree");
+    checkDotWriter<boost::directedS>(synthetic, dir, "DOT scalefree (orienté)");
+}
+
+int main() {
+    const std::string dir = (std::filesystem::temp_directory_path() /
+                             ("graphcpp_check_" + std::to_string(::getpid()))).string();
+    std::filesystem::create_directories(dir);
+
+    for (GeneratorKind kind : { GeneratorKind::Geometric, GeneratorKind::Grid, GeneratorKind::ScaleFree }) {
+        const SyntheticGraph synthetic = generateGraph(kind, 20000, 7);
+        const std::string name = generatorName(kind);
+        Graph g;
+        buildGraph(g, synthetic);
+        checkDeltaStepping(g, name);
+        checkDeltaStepping(BasicCsrGraph<UndirectedNarrowConfig>(g), name + " (CSR)");
+        DirectedGraph dg;
+        buildGraph(dg, synthetic);
+        checkDeltaStepping(dg, name + " (orienté)");
+    }
+    checkLoaders(dir);
+    checkWriters(dir);
+    std::filesystem::remove_all(dir);
+
+    std::cout << "Versions parallèles : " << checks << " vérifications, " << failures << " échec(s)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+#ifndef CONNECTED_COMPONENTS_HPP
+#define CONNECTED_COMPONENTS_HPP
+
+// Composantes connexes en parallèle par union-find sans verrou
+// - chaque thread parcourt une tranche de sommets et unit les extrémités de leurs
+//   arêtes (chaque arête non orientée n'est traitée qu'une fois, depuis u < v)
+// - graphe orienté : composantes faiblement connexes (orientation ignorée), chaque arc
+//   est uni depuis sa source
+// - union : la racine de plus grand indice est raccrochée à la plus petite par
+//   compare_exchange, ce qui ne peut pas créer de cycle ; find fait du path halving
+// - numérotation finale : les composantes sont numérotées dans l'ordre de leur plus
+//   petit sommet, le résultat ne dépend donc pas du nombre de threads
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+
+// Étiquetage complet : composante de chaque sommet et taille de chaque composante
+struct ComponentLabels {
+    std::vector<std::size_t> component;  // n : numéro de composante du sommet
+    std::vector<std::size_t> sizes;      // C : nombre de sommets de chaque composante
+
+    std::size_t count() const { return sizes.size(); }
+    std::size_t largest() const { return sizes.empty() ? 0 : *std::max_element(sizes.begin(), sizes.end()); }
+};
+
+// Répartition des tailles de composantes par puissances de 2 :
+// buckets[b] = nombre de composantes de taille dans [2^b, 2^(b+1) - 1]
+inline std::vector<std::size_t> componentSizeBuckets(const ComponentLabels& labels) {
+    std::vector<std::size_t> buckets;
+    for (std::size_t size : labels.sizes) {
+        std::size_t b = 0;
+        while ((std::size_t(2) << b) <= size) ++b;
+        if (buckets.size() <= b) buckets.resize(b + 1, 0);
+        ++buckets[b];
+    }
+    return buckets;
+}
+
+class ConcurrentUnionFind {
+public:
+    ConcurrentUnionFind() {}
+    explicit ConcurrentUnionFind(std::size_t n) { reset(n); }
+
+    // n singletons ; le tableau n'est réalloué que s'il doit grandir
+    void reset(std::size_t n) {
+        if (n > _capacity) {
+            _parent.reset(new std::atomic<std::size_t>[n]);
+            _capacity = n;
+        }
+        for (std::size_t v = 0; v < n; ++v) _parent[v].store(v, std::memory_order_relaxed);
+    }
+
+    std::size_t find(std::size_t v) {
+        for (;;) {
+            std::size_t p = _parent[v].load(std::memory_order_relaxed);
+            if (p == v) return v;
+            std::size_t gp = _parent[p].load(std::memory_order_relaxed);
+            if (gp != p) _parent[v].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            v = gp;
+        }
+    }
+
+    // vrai si a et b étaient dans deux composantes différentes
+    bool unite(std::size_t a, std::size_t b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (a < b) std::swap(a, b);
+            // a est encore une racine ? on le raccroche à b, sinon on recommence
+            std::size_t expected = a;
+            if (_parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return true;
+        }
+    }
+
+private:
+    std::unique_ptr<std::atomic<std::size_t>[]> _parent;
+    std::size_t _capacity = 0;
+};
+
+// Découpe [0, n) en tranches contiguës, une par thread ; body(begin, end, t)
+template <class Body>
+void forEachVertexRange(std::size_t n, unsigned threads, Body body) {
+    if (threads <= 1) {
+        body(std::size_t(0), n, 0u);
+        return;
+    }
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) pool.emplace_back(body, n * t / threads, n * (t + 1) / threads, t);
+    for (auto& th : pool) th.join();
+}
+
+// Nombre de threads effectif (0 = tous les coeurs, pas de thread pour moins de 1024 sommets chacun)
+inline unsigned componentThreads(std::size_t n, unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, n / 1024)));
+}
+
+// Numérotation finale à partir de l'union-find ; la compression (racine de chaque
+// sommet) est écrite directement dans labels.component puis renumérotée sur place
+inline void labelComponents(ConcurrentUnionFind& uf, std::size_t n, unsigned threads, ComponentLabels& labels) {
+    labels.component.resize(n);
+    labels.sizes.clear();
+    forEachVertexRange(n, threads, [&](std::size_t begin, std::size_t end, unsigned) {
+        for (std::size_t v = begin; v < end; ++v) labels.component[v] = uf.find(v);
+    });
+    // une racine est le plus petit sommet de sa composante : un parcours dans
+    // l'ordre des sommets rencontre chaque racine, déjà renumérotée, avant les autres membres
+    for (std::size_t v = 0; v < n; ++v) {
+        std::size_t root = labels.component[v];
+        if (root == v) {
+            labels.component[v] = labels.sizes.size();
+            labels.sizes.push_back(0);
+        } else {
+            labels.component[v] = labels.component[root];
+        }
+        ++labels.sizes[labels.component[v]];
+    }
+}
+
+// Unit les extrémités de toutes les arêtes (uf doit contenir n singletons)
+// threads : nombre effectif, voir componentThreads
+template <class G>
+void uniteAllEdges(const G& g, ConcurrentUnionFind& uf, unsigned threads) {
+    const bool directed = boost::is_directed_graph<G>::value;
+    forEachVertexRange(num_vertices(g), threads, [&](std::size_t begin, std::size_t end, unsigned) {
+        typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+        for (std::size_t u = begin; u < end; ++u) {
+            for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+                std::size_t v = target(*ei, g);
+                if (directed || u < v) uf.unite(u, v);
+            }
+        }
+    });
+}
+
+// threads = 0 : tous les coeurs
+template <class G>
+ComponentLabels connectedComponentLabels(const G& g, unsigned threads = 1) {
+    const std::size_t n = num_vertices(g);
+    threads = componentThreads(n, threads);
+
+    ConcurrentUnionFind uf(n);
+    uniteAllEdges(g, uf, threads);
+
+    ComponentLabels labels;
+    labelComponents(uf, n, threads, labels);
+    return labels;
+}
+
+#endif
@@ -0,0 +1,347 @@
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+// Graphe figé au format CSR (compressed sparse row) pour l'analyse en lecture seule.
+// Après loadEdges la topologie ne change plus : toutes les listes d'adjacence sont
+// rangées dans des tableaux contigus (offsets, cibles, numéros d'arête) au lieu d'un
+// vecteur alloué par sommet plus la std::list d'arêtes de l'adjacency_list.
+// La classe modélise les concepts BGL utilisés par l'analyse (VertexListGraph,
+// IncidenceGraph, EdgeListGraph) : les algorithmes Boost (Dijkstra, DFS, composantes
+// connexes, write_graphviz) marchent tels quels.
+// Orientation, type des poids et largeur des indices stockés viennent de la configuration
+// (graph_config.hpp) : en orienté chaque arc n'occupe qu'une case, rangée par source, et
+// son numéro est celui de sa case ; en 32 bits / float les tableaux font moitié moins.
+// Les propriétés sont stockées en SoA (voir soa_properties.hpp) : get(&NodeInfo::x, g),
+// get(&EdgeInfo::weight, g)... renvoient des property maps sur ces tableaux.
+// Les tableaux peuvent aussi pointer directement dans un snapshot binaire projeté en
+// mémoire (graph_snapshot.hpp) : le graphe garde alors la projection en vie.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include "graph_types.hpp"
+#include "graph_config.hpp"
+#include "soa_properties.hpp"
+#include "csv_mmap.hpp"
+
+// Descripteur d'arête : extrémités vues depuis le sommet parcouru + numéro de l'arête
+// deux descripteurs sont égaux s'ils désignent la même arête (u-v == v-u)
+struct CsrEdge {
+    std::size_t src;
+    std::size_t tgt;
+    std::size_t idx;  // indice dans les tableaux indexés par arête
+    bool operator==(const CsrEdge& o) const { return idx == o.idx; }
+    bool operator!=(const CsrEdge& o) const { return idx != o.idx; }
+};
+
+// Parcourt les cases [k, k_end) de la ligne CSR du sommet u
+template <class G>
+class CsrOutEdgeIterator
+    : public boost::iterator_facade<CsrOutEdgeIterator<G>, CsrEdge,
+                                    boost::forward_traversal_tag, CsrEdge> {
+public:
+    CsrOutEdgeIterator() {}
+    CsrOutEdgeIterator(const G* g, std::size_t u, std::size_t k) : _g(g), _u(u), _k(k) {}
+private:
+    friend class boost::iterator_core_access;
+    CsrEdge dereference() const {
+        CsrEdge e = { _u, _g->slotTarget(_k), _g->slotEdge(_k) };
+        return e;
+    }
+    bool equal(const CsrOutEdgeIterator& o) const { return _k == o._k; }
+    void increment() { ++_k; }
+
+    const G* _g = nullptr;
+    std::size_t _u = 0;
+    std::size_t _k = 0;
+};
+
+// Parcourt les arêtes dans leur ordre d'insertion (même ordre que edges() sur l'adjacency_list)
+template <class G>
+class CsrEdgeIterator
+    : public boost::iterator_facade<CsrEdgeIterator<G>, CsrEdge,
+                                    boost::forward_traversal_tag, CsrEdge> {
+public:
+    CsrEdgeIterator() {}
+    CsrEdgeIterator(const G* g, std::size_t idx) : _g(g), _idx(idx) {}
+private:
+    friend class boost::iterator_core_access;
+    CsrEdge dereference() const {
+        CsrEdge e = { _g->edgeSource(_idx), _g->edgeTarget(_idx), _idx };
+        return e;
+    }
+    bool equal(const CsrEdgeIterator& o) const { return _idx == o._idx; }
+    void increment() { ++_idx; }
+
+    const G* _g = nullptr;
+    std::size_t _idx = 0;
+};
+
+template <class Config>
+class BasicCsrGraph {
+public:
+    typedef Config config_type;
+    typedef typename Config::weight_type weight_type;
+    typedef typename Config::index_type index_type;
+
+    // Types attendus par boost::graph_traits
+    typedef std::size_t vertex_descriptor;
+    typedef CsrEdge edge_descriptor;
+    typedef typename Config::directed_category directed_category;
+    typedef boost::allow_parallel_edge_tag edge_parallel_category;
+    struct traversal_category : boost::incidence_graph_tag,
+                                boost::vertex_list_graph_tag,
+                                boost::edge_list_graph_tag {};
+    typedef boost::counting_iterator<std::size_t> vertex_iterator;
+    typedef CsrOutEdgeIterator<BasicCsrGraph> out_edge_iterator;
+    typedef CsrEdgeIterator<BasicCsrGraph> edge_iterator;
+    typedef std::size_t vertices_size_type;
+    typedef std::size_t edges_size_type;
+    typedef std::size_t degree_size_type;
+    static vertex_descriptor null_vertex() { return static_cast<vertex_descriptor>(-1); }
+
+    BasicCsrGraph() {}
+
+    // Fige un graphe déjà chargé (Graph, ou DirectedGraph pour une configuration orientée),
+    // en deux passes (degrés puis remplissage)
+    // non orienté : les arêtes sont parcourues dans l'ordre d'insertion et ajoutées aux deux
+    // extrémités, ce qui reproduit exactement l'ordre des out_edges de l'adjacency_list
+    // orienté : chaque arc est rangé dans la ligne de sa source
+    template <class Source>
+    explicit BasicCsrGraph(const Source& g) {
+        static_assert(boost::is_directed_graph<Source>::value == Config::directed,
+                      "orientation du graphe source différente de la configuration");
+        const std::size_t n = boost::num_vertices(g);
+        const std::size_t m = boost::num_edges(g);
+        _ids.resize(n);
+        _coords.resize(n);
+        for (std::size_t v = 0; v < n; ++v) {
+            _ids[v] = g[v].id;
+            _coords.x[v] = g[v].x;
+            _coords.y[v] = g[v].y;
+            _coords.z[v] = g[v].z;
+        }
+        _idMap = nodeIdMap(g);
+
+        _inPath.resize(m);
+        _offsets.assign(n + 1, 0);
+        if (Config::directed) {
+            // sommets puis out_edges : même ordre que edges(g), sans l'edge_iterator orienté
+            // de Boost (faux positifs -Wmaybe-uninitialized, voir graph_types.hpp)
+            for (std::size_t v = 0; v < n; ++v) _offsets[v + 1] = _offsets[v] + boost::out_degree(v, g);
+            _targets.resize(m);
+            _edgeSource.resize(m);
+            _weight.resize(m);
+            typename boost::graph_traits<Source>::out_edge_iterator oi, oi_end;
+            std::size_t k = 0;
+            for (std::size_t v = 0; v < n; ++v) {
+                for (boost::tie(oi, oi_end) = boost::out_edges(v, g); oi != oi_end; ++oi, ++k) {
+                    _edgeSource[k] = static_cast<index_type>(v);
+                    _targets[k] = static_cast<index_type>(boost::target(*oi, g));
+                    _weight[k] = static_cast<weight_type>(g[*oi].weight);
+                    _inPath[k] = g[*oi].inPath;
+                }
+            }
+            return;
+        }
+
+        typename boost::graph_traits<Source>::edge_iterator ei, ei_end;
+
+        _edgeSource.reserve(m);
+        _edgeTarget.reserve(m);
+        _weight.reserve(m);
+        for (boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei) {
+            std::size_t s = boost::source(*ei, g), t = boost::target(*ei, g);
+            _edgeSource.push_back(static_cast<index_type>(s));
+            _edgeTarget.push_back(static_cast<index_type>(t));
+            _inPath[_weight.size()] = g[*ei].inPath;
+            _weight.push_back(static_cast<weight_type>(g[*ei].weight));
+            ++_offsets[s + 1];
+            ++_offsets[t + 1];
+        }
+        for (std::size_t v = 0; v < n; ++v) _offsets[v + 1] += _offsets[v];
+
+        _targets.resize(2 * m);
+        _slotEdge.resize(2 * m);
+        std::vector<std::size_t> cursor(_offsets.begin(), _offsets.end() - 1);
+        for (std::size_t e = 0; e < m; ++e) {
+            std::size_t s = _edgeSource[e], t = _edgeTarget[e];
+            _targets[cursor[s]] = static_cast<index_type>(t);
+            _slotEdge[cursor[s]++] = static_cast<index_type>(e);
+            _targets[cursor[t]] = static_cast<index_type>(s);
+            _slotEdge[cursor[t]++] = static_cast<index_type>(e);
+        }
+    }
+
+    std::size_t vertexCount() const { return _ids.size(); }
+    std::size_t edgeCount() const { return _weight.size(); }
+    std::size_t rowBegin(std::size_t u) const { return _offsets[u]; }
+    std::size_t rowEnd(std::size_t u) const { return _offsets[u + 1]; }
+    std::size_t slotTarget(std::size_t k) const { return _targets[k]; }
+    std::size_t slotEdge(std::size_t k) const { return Config::directed ? k : _slotEdge[k]; }
+    std::size_t edgeSource(std::size_t e) const { return _edgeSource[e]; }
+    std::size_t edgeTarget(std::size_t e) const { return Config::directed ? _targets[e] : _edgeTarget[e]; }
+    const SoaArray<index_type>& edgeSources() const { return _edgeSource; }
+    const SoaArray<index_type>& edgeTargets() const { return Config::directed ? _targets : _edgeTarget; }
+
+    // Tableaux de propriétés (SoA)
+    SoaArray<NodeId>& ids() { return _ids; }
+    const SoaArray<NodeId>& ids() const { return _ids; }
+    const NodeIdMap& idMap() const { return _idMap; }
+    NodeCoords& coords() { return _coords; }
+    const NodeCoords& coords() const { return _coords; }
+    SoaArray<weight_type>& weights() { return _weight; }
+    const SoaArray<weight_type>& weights() const { return _weight; }
+    boost::dynamic_bitset<>& inPath() { return _inPath; }
+    const boost::dynamic_bitset<>& inPath() const { return _inPath; }
+
+    // Octets des tableaux du graphe (sans la correspondance des IDs)
+    std::size_t memoryBytes() const {
+        return _ids.size() * sizeof(NodeId) + 3 * _coords.size() * sizeof(double) + _inPath.size() / 8 +
+               (_offsets.size() + _targets.size() + _slotEdge.size() + _edgeSource.size() + _edgeTarget.size()) *
+                   sizeof(index_type) +
+               _weight.size() * sizeof(weight_type);
+    }
+
+private:
+    // le snapshot écrit et projette directement les tableaux
+    friend struct SnapshotIo;
+
+    SoaArray<index_type> _offsets;     // n + 1 : ligne du sommet u = [_offsets[u], _offsets[u+1])
+    SoaArray<index_type> _targets;     // 2m (orienté : m) : voisin pour chaque case
+    SoaArray<index_type> _slotEdge;    // 2m : numéro de l'arête pour chaque case (vide en orienté)
+    SoaArray<index_type> _edgeSource;  // m : extrémités dans l'ordre d'insertion
+    SoaArray<index_type> _edgeTarget;  // (vide en orienté : c'est _targets)
+    SoaArray<NodeId> _ids;              // n : ID du nœud dans le CSV
+    NodeIdMap _idMap;                   // ID du CSV -> indice (reconstruit au chargement d'un snapshot)
+    NodeCoords _coords;                 // n : x[], y[], z[]
+    SoaArray<weight_type> _weight;      // m : poids des arêtes
+    boost::dynamic_bitset<> _inPath;    // m : arêtes du chemin surligné
+    std::shared_ptr<MappedFile> _storage;  // projection du snapshot quand les tableaux sont des vues
+};
+
+// Configuration historique : non orienté, poids double, indices 64 bits
+typedef BasicCsrGraph<UndirectedConfig> CsrGraph;
+
+// Fonctions libres de l'interface BGL (trouvées par ADL depuis les algorithmes Boost)
+template <class C>
+std::pair<boost::counting_iterator<std::size_t>, boost::counting_iterator<std::size_t>>
+vertices(const BasicCsrGraph<C>& g) {
+    typedef boost::counting_iterator<std::size_t> Iterator;
+    return std::make_pair(Iterator(0), Iterator(g.vertexCount()));
+}
+template <class C>
+std::size_t num_vertices(const BasicCsrGraph<C>& g) { return g.vertexCount(); }
+template <class C>
+std::size_t num_edges(const BasicCsrGraph<C>& g) { return g.edgeCount(); }
+template <class C>
+const NodeIdMap& nodeIdMap(const BasicCsrGraph<C>& g) { return g.idMap(); }
+
+template <class C>
+std::pair<CsrOutEdgeIterator<BasicCsrGraph<C>>, CsrOutEdgeIterator<BasicCsrGraph<C>>>
+out_edges(std::size_t u, const BasicCsrGraph<C>& g) {
+    typedef CsrOutEdgeIterator<BasicCsrGraph<C>> Iterator;
+    return std::make_pair(Iterator(&g, u, g.rowBegin(u)), Iterator(&g, u, g.rowEnd(u)));
+}
+template <class C>
+std::size_t out_degree(std::size_t u, const BasicCsrGraph<C>& g) { return g.rowEnd(u) - g.rowBegin(u); }
+template <class C>
+std::size_t degree(std::size_t u, const BasicCsrGraph<C>& g) { return out_degree(u, g); }
+
+template <class C>
+std::pair<CsrEdgeIterator<BasicCsrGraph<C>>, CsrEdgeIterator<BasicCsrGraph<C>>> edges(const BasicCsrGraph<C>& g) {
+    typedef CsrEdgeIterator<BasicCsrGraph<C>> Iterator;
+    return std::make_pair(Iterator(&g, 0), Iterator(&g, g.edgeCount()));
+}
+template <class C>
+std::size_t source(const CsrEdge& e, const BasicCsrGraph<C>&) { return e.src; }
+template <class C>
+std::size_t target(const CsrEdge& e, const BasicCsrGraph<C>&) { return e.tgt; }
+
+// Recherche linéaire dans la ligne de u (les chemins n'ont que quelques arêtes)
+template <class C>
+std::pair<CsrEdge, bool> edge(std::size_t u, std::size_t v, const BasicCsrGraph<C>& g) {
+    for (std::size_t k = g.rowBegin(u); k < g.rowEnd(u); ++k) {
+        if (g.slotTarget(k) == v) {
+            CsrEdge e = { u, v, g.slotEdge(k) };
+            return std::make_pair(e, true);
+        }
+    }
+    CsrEdge none = { u, v, 0 };
+    return std::make_pair(none, false);
+}
+
+// Les tableaux par arête sont indexés par le numéro d'arête
+inline std::size_t soaKeyIndex(const CsrEdge& e) { return e.idx; }
+
+// Property maps sur les tableaux SoA, même syntaxe que les bundles : get(&EdgeInfo::weight, g)
+// (poids lus et écrits dans le type de la configuration)
+template <class C>
+SoaArrayMap<std::size_t, NodeId> get(NodeId NodeInfo::*, BasicCsrGraph<C>& g) {
+    return SoaArrayMap<std::size_t, NodeId>(g.ids().data());
+}
+template <class C>
+SoaArrayMap<std::size_t, const NodeId> get(NodeId NodeInfo::*, const BasicCsrGraph<C>& g) {
+    return SoaArrayMap<std::size_t, const NodeId>(g.ids().data());
+}
+template <class C>
+SoaArrayMap<std::size_t, double> get(double NodeInfo::*member, BasicCsrGraph<C>& g) {
+    return SoaArrayMap<std::size_t, double>(g.coords().array(member));
+}
+template <class C>
+SoaArrayMap<std::size_t, const double> get(double NodeInfo::*member, const BasicCsrGraph<C>& g) {
+    return SoaArrayMap<std::size_t, const double>(g.coords().array(member));
+}
+template <class C>
+SoaArrayMap<CsrEdge, typename C::weight_type> get(double EdgeInfo::*, BasicCsrGraph<C>& g) {
+    return SoaArrayMap<CsrEdge, typename C::weight_type>(g.weights().data());
+}
+template <class C>
+SoaArrayMap<CsrEdge, const typename C::weight_type> get(double EdgeInfo::*, const BasicCsrGraph<C>& g) {
+    return SoaArrayMap<CsrEdge, const typename C::weight_type>(g.weights().data());
+}
+template <class C>
+SoaBitMap<CsrEdge, boost::dynamic_bitset<>> get(bool EdgeInfo::*, BasicCsrGraph<C>& g) {
+    return SoaBitMap<CsrEdge, boost::dynamic_bitset<>>(&g.inPath());
+}
+template <class C>
+SoaBitMap<CsrEdge, const boost::dynamic_bitset<>> get(bool EdgeInfo::*, const BasicCsrGraph<C>& g) {
+    return SoaBitMap<CsrEdge, const boost::dynamic_bitset<>>(&g.inPath());
+}
+
+// Recalcule tous les poids à partir des coordonnées actuelles (topologie inchangée)
+// en une passe du noyau SIMD sur les tableaux d'extrémités
+template <class C>
+void recomputeWeights(BasicCsrGraph<C>& g, WeightKernel kernel = bestWeightKernel()) {
+    const NodeCoords& c = g.coords();
+    computeWeightsBatch(c.x.data(), c.y.data(), c.z.data(), g.edgeSources().data(),
+                        g.edgeTargets().data(), g.weights().data(), g.edgeCount(), kernel);
+}
+
+// Les sommets sont déjà numérotés 0..n-1
+template <class C>
+boost::typed_identity_property_map<std::size_t> get(boost::vertex_index_t, const BasicCsrGraph<C>&) {
+    return boost::typed_identity_property_map<std::size_t>();
+}
+template <class C>
+std::size_t get(boost::vertex_index_t, const BasicCsrGraph<C>&, std::size_t v) { return v; }
+
+namespace boost {
+template <class C>
+struct property_map<BasicCsrGraph<C>, vertex_index_t> {
+    typedef typed_identity_property_map<std::size_t> type;
+    typedef type const_type;
+};
+}
+
+#endif
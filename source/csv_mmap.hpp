@@ -0,0 +1,170 @@
+#ifndef CSV_MMAP_HPP
+#define CSV_MMAP_HPP
+
+// Lecture des CSV sans copie :
+// le fichier est projeté en mémoire (mmap), les lignes sont découpées sur place
+// et les champs sont convertis directement depuis le buffer avec std::from_chars
+// (pas de std::string par ligne ni par token comme avec boost::tokenizer)
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Fichier projeté en lecture seule, libéré automatiquement (RAII)
+// copyOnWrite : projection modifiable mais privée (les pages écrites sont copiées,
+// le fichier n'est jamais modifié), utilisée pour les snapshots binaires
+class MappedFile {
+public:
+    MappedFile() {}
+    explicit MappedFile(const std::string& filename, bool copyOnWrite = false) { open(filename, copyOnWrite); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename, bool copyOnWrite = false) {
+        close();
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        _size = static_cast<std::size_t>(st.st_size);
+        _opened = true;
+        // mmap refuse une taille nulle : un fichier vide est simplement un buffer vide
+        if (_size > 0) {
+            int prot = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+            void* p = ::mmap(nullptr, _size, prot, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                _size = 0;
+                _opened = false;
+                return false;
+            }
+            // CSV : lecture linéaire, le noyau peut lire en avance
+            if (!copyOnWrite) ::madvise(p, _size, MADV_SEQUENTIAL);
+            _data = static_cast<const char*>(p);
+        }
+        ::close(fd); // la projection reste valide après fermeture du descripteur
+        return true;
+    }
+
+    void close() {
+        if (_data) ::munmap(const_cast<char*>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+        _opened = false;
+    }
+
+    bool is_open() const { return _opened; }
+    const char* begin() const { return _data; }
+    char* data() { return const_cast<char*>(_data); }  // modifiable seulement en copyOnWrite
+    const char* end() const { return _data + _size; }
+    std::size_t size() const { return _size; }
+
+private:
+    const char* _data = nullptr;
+    std::size_t _size = 0;
+    bool _opened = false;
+};
+
+// Une portion [begin, end) du buffer, équivalent d'un string_view
+struct CsvField {
+    const char* begin;
+    const char* end;
+    bool empty() const { return begin == end; }
+};
+
+// Saute le BOM UTF-8 (EF BB BF) en tête de fichier, comme celui de nodes.csv
+inline void skipUtf8Bom(const char*& p, const char* end) {
+    if (end - p >= 3 && static_cast<unsigned char>(p[0]) == 0xEF &&
+        static_cast<unsigned char>(p[1]) == 0xBB && static_cast<unsigned char>(p[2]) == 0xBF) {
+        p += 3;
+    }
+}
+
+// Extrait la ligne suivante (sans le \n ni le \r des fichiers Windows)
+// retourne false quand il n'y a plus rien à lire
+inline bool nextLine(const char*& p, const char* end, CsvField& line) {
+    if (p >= end) return false;
+    const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (!eol) eol = end;
+    line.begin = p;
+    line.end = eol;
+    if (line.end > line.begin && line.end[-1] == '\r') --line.end;
+    p = (eol < end) ? eol + 1 : end;
+    return true;
+}
+
+// Extrait le champ suivant d'une ligne, les champs vides sont sautés
+// (même comportement que boost::char_separator<char>(";"))
+inline bool nextField(const char*& p, const char* end, CsvField& field, char sep = ';') {
+    while (p < end && *p == sep) ++p;
+    if (p >= end) return false;
+    field.begin = p;
+    while (p < end && *p != sep) ++p;
+    field.end = p;
+    return true;
+}
+
+// Enlève les espaces autour d'un champ (std::stoi/std::stod les ignoraient)
+inline CsvField trimField(CsvField f) {
+    while (f.begin < f.end && (*f.begin == ' ' || *f.begin == '\t')) ++f.begin;
+    while (f.end > f.begin && (f.end[-1] == ' ' || f.end[-1] == '\t' || f.end[-1] == '\r')) --f.end;
+    return f;
+}
+
+// Conversion sans allocation, retourne false si le champ n'est pas un nombre
+inline bool parseField(CsvField f, int& value) {
+    f = trimField(f);
+    if (f.begin < f.end && *f.begin == '+') ++f.begin; // from_chars refuse le '+'
+    std::from_chars_result r = std::from_chars(f.begin, f.end, value);
+    return r.ec == std::errc() && r.ptr != f.begin;
+}
+
+inline bool parseField(CsvField f, std::int64_t& value) {
+    f = trimField(f);
+    if (f.begin < f.end && *f.begin == '+') ++f.begin;
+    std::from_chars_result r = std::from_chars(f.begin, f.end, value);
+    return r.ec == std::errc() && r.ptr != f.begin;
+}
+
+inline bool parseField(CsvField f, double& value) {
+    f = trimField(f);
+    if (f.begin < f.end && *f.begin == '+') ++f.begin;
+    std::from_chars_result r = std::from_chars(f.begin, f.end, value);
+    return r.ec == std::errc() && r.ptr != f.begin;
+}
+
+// Découpe [begin, end) en au plus `parts` tranches de tailles proches,
+// chaque coupure est reculée juste après un '\n' pour ne jamais couper une ligne
+inline std::vector<CsvField> splitOnLines(const char* begin, const char* end, unsigned parts) {
+    std::vector<CsvField> chunks;
+    if (parts == 0) parts = 1;
+    const std::size_t step = (end - begin) / parts + 1;
+    const char* p = begin;
+    while (p < end) {
+        const char* cut = (static_cast<std::size_t>(end - p) > step) ? p + step : end;
+        if (cut < end) {
+            const char* eol = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+            cut = eol ? eol + 1 : end;
+        }
+        CsvField chunk = { p, cut };
+        chunks.push_back(chunk);
+        p = cut;
+    }
+    return chunks;
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef CYCLE_DETECTION_HPP
+#define CYCLE_DETECTION_HPP
+
+// Détection de cycle avec arrêt au premier cycle
+// - parcours en profondeur itératif (pile explicite, pas de récursion sur les
+//   grands graphes) ; en non orienté l'arête par laquelle on est arrivé sur un sommet
+//   est ignorée (boost::depth_first_search la signale comme arête arrière en non orienté),
+//   une arête parallèle ou une boucle compte en revanche comme un cycle
+// - la première arête vers un sommet encore sur la pile ferme un cycle : on remonte
+//   les parents pour obtenir le cycle témoin et on s'arrête là
+// - graphe orienté : seuls les arcs arrière (vers un sommet sur la pile) ferment un cycle
+//   orienté, un arc vers un sommet déjà terminé n'en ferme pas ; u -> v -> u est un cycle
+// - raccourci O(1), non orienté seulement : une forêt a exactement V - C arêtes
+//   (C composantes connexes), au-delà le graphe contient forcément un cycle
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include "connected_components.hpp"
+
+// Vrai si le graphe non orienté contient un cycle, sans parcours : E > V - C
+template <class G>
+bool hasCycleByCount(const G& g, const ComponentLabels& components) {
+    return num_edges(g) + components.count() > num_vertices(g);
+}
+
+// Sommets d'un cycle (v0, v1, ..., vk, l'arête vk-v0 le ferme), vide si le graphe est une forêt
+// (orienté : v0 -> v1 -> ... -> vk -> v0, vide si le graphe est acyclique)
+template <class G>
+std::vector<typename boost::graph_traits<G>::vertex_descriptor> findCycle(const G& g) {
+    typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+    typedef typename boost::graph_traits<G>::edge_descriptor Edge;
+    typedef typename boost::graph_traits<G>::out_edge_iterator OutEdgeIterator;
+    enum : unsigned char { White = 0, Gray = 1, Black = 2 };
+    const bool directed = boost::is_directed_graph<G>::value;
+
+    const std::size_t n = num_vertices(g);
+    std::vector<Vertex> cycle;
+    // calloc : les pages à zéro sont fournies à la demande, un parcours qui
+    // s'arrête tôt ne paie pas l'initialisation de tout le tableau
+    std::unique_ptr<unsigned char, decltype(&std::free)> color(
+        static_cast<unsigned char*>(std::calloc(std::max<std::size_t>(n, 1), 1)), &std::free);
+    std::unique_ptr<Vertex[]> parent(new Vertex[std::max<std::size_t>(n, 1)]);
+
+    struct Frame {
+        Vertex u;
+        Edge from;      // arête d'arrivée (ignorée une fois)
+        bool hasFrom;
+        OutEdgeIterator next, end;
+    };
+    std::vector<Frame> stack;
+
+    for (std::size_t root = 0; root < n; ++root) {
+        if (color.get()[root] != White) continue;
+        Frame f;
+        f.u = static_cast<Vertex>(root);
+        f.hasFrom = false;
+        boost::tie(f.next, f.end) = out_edges(f.u, g);
+        color.get()[root] = Gray;
+        parent[root] = f.u;
+        stack.push_back(f);
+
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.next == top.end) {
+                color.get()[top.u] = Black;
+                stack.pop_back();
+                continue;
+            }
+            Edge e = *top.next++;
+            if (!directed && top.hasFrom && e == top.from) continue;
+            Vertex u = top.u;
+            Vertex v = target(e, g);
+            if (color.get()[v] == White) {
+                Frame child;
+                child.u = v;
+                child.from = e;
+                child.hasFrom = true;
+                boost::tie(child.next, child.end) = out_edges(v, g);
+                color.get()[v] = Gray;
+                parent[v] = u;
+                stack.push_back(child);  // top n'est plus valide après push_back
+            } else if (color.get()[v] == Gray) {
+                // v est un ancêtre de u (ou u lui-même pour une boucle)
+                for (Vertex w = u; w != v; w = parent[w]) cycle.push_back(w);
+                cycle.push_back(v);
+                std::reverse(cycle.begin(), cycle.end());
+                return cycle;
+            }
+        }
+    }
+    return cycle;
+}
+
+#endif
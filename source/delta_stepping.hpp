@@ -0,0 +1,309 @@
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+// Plus courts chemins depuis une source en parallèle (delta-stepping, Meyer & Sanders)
+// - les distances provisoires sont rangées dans des seaux de largeur delta ; tous les
+//   sommets du plus petit seau non vide sont traités en même temps, par phases :
+//   arêtes légères (poids <= delta) tant que le seau se remplit à nouveau, puis arêtes
+//   lourdes une seule fois pour les sommets sortis du seau
+// - chaque sommet appartient à un thread (v % threads) qui est le seul à écrire sa
+//   distance, son prédécesseur et ses seaux : les threads qui parcourent les arêtes
+//   déposent des demandes (sommet, distance, prédécesseur) dans la boîte du propriétaire,
+//   appliquées après une barrière => distance et prédécesseur toujours cohérents, sans atomiques
+// - les sommets à parcourir sont distribués dynamiquement par blocs entre les threads
+// Les distances sont exactement celles de Dijkstra (même minimum de d(u) + w sur les
+// mêmes valeurs) ; en cas d'égalité exacte entre deux chemins, le prédécesseur retenu
+// peut différer, l'arbre reste un arbre de plus courts chemins.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include "graph_types.hpp"
+#include "metrics.hpp"
+
+// Largeur des seaux tirée des poids : poids moyen d'un échantillon d'arêtes (toutes les
+// arêtes d'au plus 4096 sommets répartis sur le graphe) multiplié par `factor`.
+// Plus large : moins de phases mais plus de distances corrigées plusieurs fois
+template <class G>
+double deltaSteppingWidth(const G& g, double factor = 2.0) {
+    const std::size_t n = num_vertices(g);
+    const std::size_t step = std::max<std::size_t>(1, n / 4096);
+    auto weights = get(&EdgeInfo::weight, g);
+    double total = 0.0;
+    std::size_t count = 0;
+    typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+    for (std::size_t v = 0; v < n; v += step) {
+        for (boost::tie(ei, ei_end) = out_edges(v, g); ei != ei_end; ++ei) {
+            total += get(weights, *ei);
+            ++count;
+        }
+    }
+    double delta = count ? factor * total / count : 1.0;
+    return delta > 0 ? delta : 1.0;
+}
+
+// Barrière réutilisable (attente active avec yield : les phases sont courtes)
+class SpinBarrier {
+public:
+    explicit SpinBarrier(unsigned count) : _count(count), _waiting(0), _generation(0) {}
+
+    void wait() {
+        if (_count == 1) return;
+        unsigned generation = _generation.load(std::memory_order_acquire);
+        if (_waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == _count) {
+            _waiting.store(0, std::memory_order_relaxed);
+            _generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        while (_generation.load(std::memory_order_acquire) == generation) std::this_thread::yield();
+    }
+
+private:
+    const unsigned _count;
+    std::atomic<unsigned> _waiting;
+    std::atomic<unsigned> _generation;
+};
+
+template <class G>
+class DeltaSteppingWorkspace {
+public:
+    typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+
+    explicit DeltaSteppingWorkspace(std::size_t n)
+        : _dist(n), _pred(n), _reached(n, 0), _inFrontier(n, 0), _removed(n, 0) {}
+
+    // Delta-stepping depuis source avec `threads` threads (0 = tous les coeurs), arrêté dès
+    // que toutes les cibles ont leur distance définitive (sans cible, toute la composante)
+    void run(const G& g, Vertex source, const std::vector<Vertex>& targets, unsigned threads, double delta) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        newEpoch();
+        _targets = &targets;
+        _delta = delta;
+        _threads = threads;
+        // seaux et boîtes gardés d'une exécution à l'autre (vides, capacité conservée)
+        if (_owners.size() != threads) {
+            _owners.assign(threads, Owner());
+            _outbox.assign(std::size_t(threads) * threads, std::vector<Request>());
+        }
+        for (Owner& o : _owners) {
+            for (auto& bucket : o.buckets) bucket.clear();  // restes d'une exécution arrêtée sur ses cibles
+            o.removed.clear();
+            o.lowest = 0;
+            o.settled = 0;
+        }
+        _barrier.reset(new SpinBarrier(threads));
+        _lightNext.store(0);
+        _heavyNext.store(0);
+
+        Owner& first = _owners[source % threads];
+        reach(source, 0.0, source);
+        first.bucket(0).push_back(source);
+
+        if (threads == 1) {
+            worker(g, 0);
+        } else {
+            std::vector<std::thread> pool;
+            for (unsigned t = 0; t < threads; ++t) pool.emplace_back([this, &g, t]() { worker(g, t); });
+            for (auto& th : pool) th.join();
+        }
+        std::uint64_t settled = 0;
+        for (const Owner& o : _owners) settled += o.settled;
+        Metrics::add(Counter::VerticesSettled, settled);
+        _targets = nullptr;
+    }
+
+    bool reached(Vertex v) const { return _reached[v] == _epoch; }
+    double distance(Vertex v) const { return _dist[v]; }
+    Vertex predecessor(Vertex v) const { return _pred[v]; }
+
+    // Chemin source -> target de la dernière requête, en IDs du CSV
+    PathResult path(const G& g, Vertex source, Vertex target) const {
+        if (!reached(target)) return PathResult(-1, {});
+        std::vector<NodeId> path;
+        auto ids = get(&NodeInfo::id, g);
+        for (Vertex v = target; ; v = _pred[v]) {
+            path.push_back(get(ids, v));
+            if (v == source) break;
+        }
+        std::reverse(path.begin(), path.end());
+        return PathResult(_dist[target], path);
+    }
+
+private:
+    static constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t kChunk = 256;  // sommets pris à la fois par un thread
+
+    struct Request {
+        Vertex v, from;
+        double d;
+    };
+
+    // Seaux et listes d'un thread propriétaire, pour ses seuls sommets
+    struct Owner {
+        std::vector<std::vector<Vertex>> buckets;
+        std::vector<Vertex> frontier;   // sommets du seau courant à parcourir dans cette phase
+        std::vector<Vertex> removed;    // sommets sortis du seau courant (arêtes lourdes)
+        std::size_t lowest = 0;         // aucun seau non vide en dessous
+        std::uint64_t settled = 0;
+
+        std::vector<Vertex>& bucket(std::size_t b) {
+            if (b >= buckets.size()) buckets.resize(b + 1);
+            return buckets[b];
+        }
+        std::size_t firstNonEmpty() {
+            while (lowest < buckets.size() && buckets[lowest].empty()) ++lowest;
+            return lowest < buckets.size() ? lowest : kNone;
+        }
+    };
+
+    void worker(const G& g, unsigned t) {
+        Owner& own = _owners[t];
+        auto weights = get(&EdgeInfo::weight, g);
+        unsigned phase = _stamp, round = _stamp;
+
+        for (;;) {
+            // plus petit seau non vide, tous propriétaires confondus
+            own.firstNonEmpty();
+            _barrier->wait();
+            std::size_t current = kNone;
+            for (Owner& o : _owners) current = std::min(current, o.lowest < o.buckets.size() ? o.lowest : kNone);
+            if (current == kNone || targetsSettled(current)) break;
+            ++round;
+
+            // phases légères : le seau courant peut se remplir de nouveau
+            for (;;) {
+                ++phase;
+                own.frontier.clear();
+                if (current < own.buckets.size()) {
+                    for (Vertex v : own.buckets[current]) {
+                        // entrée périmée (distance améliorée depuis) ou déjà prise dans cette phase
+                        if (bucketOf(_dist[v]) != current || _inFrontier[v] == phase) continue;
+                        _inFrontier[v] = phase;
+                        own.frontier.push_back(v);
+                        if (_removed[v] != round) {
+                            _removed[v] = round;
+                            own.removed.push_back(v);
+                        }
+                    }
+                    own.buckets[current].clear();
+                }
+                if (t == 0) _lightNext.store(0, std::memory_order_relaxed);
+                _barrier->wait();
+                bool empty = true;
+                for (const Owner& o : _owners) empty = empty && o.frontier.empty();
+                if (empty) break;
+                relaxFrom(g, weights, t, &Owner::frontier, _lightNext, true);
+                _barrier->wait();
+                applyRequests(t);
+            }
+
+            // arêtes lourdes des sommets sortis du seau, une seule fois
+            if (t == 0) _heavyNext.store(0, std::memory_order_relaxed);
+            _barrier->wait();
+            relaxFrom(g, weights, t, &Owner::removed, _heavyNext, false);
+            _barrier->wait();
+            own.settled += own.removed.size();
+            own.removed.clear();
+            applyRequests(t);
+        }
+        if (t == 0) _stamp = std::max(phase, round);
+    }
+
+    // Parcourt les arêtes (légères ou lourdes) des listes `list` de tous les propriétaires,
+    // par blocs de kChunk sommets pris dans l'ordre par le prochain thread libre
+    template <class Weights>
+    void relaxFrom(const G& g, const Weights& weights, unsigned t, std::vector<Vertex> Owner::*list,
+                   std::atomic<std::size_t>& next, bool light) {
+        std::vector<std::size_t> offsets(_threads + 1, 0);
+        for (unsigned o = 0; o < _threads; ++o) offsets[o + 1] = offsets[o] + (_owners[o].*list).size();
+        const std::size_t total = offsets[_threads];
+        std::vector<Request>* outbox = &_outbox[std::size_t(t) * _threads];
+        typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+        for (std::size_t begin = next.fetch_add(kChunk); begin < total; begin = next.fetch_add(kChunk)) {
+            std::size_t end = std::min(total, begin + kChunk);
+            unsigned o = static_cast<unsigned>(std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1);
+            for (std::size_t k = begin; k < end; ++k) {
+                while (k >= offsets[o + 1]) ++o;
+                Vertex u = (_owners[o].*list)[k - offsets[o]];
+                const double du = _dist[u];
+                for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+                    double w = get(weights, *ei);
+                    if ((w <= _delta) != light) continue;
+                    Vertex v = target(*ei, g);
+                    outbox[v % _threads].push_back(Request{ v, u, du + w });
+                }
+            }
+        }
+    }
+
+    // Demandes reçues par le propriétaire t, dans l'ordre des threads émetteurs
+    void applyRequests(unsigned t) {
+        Owner& own = _owners[t];
+        for (unsigned s = 0; s < _threads; ++s) {
+            std::vector<Request>& inbox = _outbox[std::size_t(s) * _threads + t];
+            for (const Request& r : inbox) {
+                if (_reached[r.v] == _epoch && r.d >= _dist[r.v]) continue;
+                reach(r.v, r.d, r.from);
+                std::size_t b = bucketOf(r.d);
+                own.bucket(b).push_back(r.v);
+                own.lowest = std::min(own.lowest, b);
+            }
+            inbox.clear();
+        }
+    }
+
+    // Toutes les distances < current * delta sont définitives
+    bool targetsSettled(std::size_t current) const {
+        if (_targets->empty()) return false;
+        for (Vertex v : *_targets) {
+            if (_reached[v] != _epoch || bucketOf(_dist[v]) >= current) return false;
+        }
+        return true;
+    }
+
+    std::size_t bucketOf(double d) const { return static_cast<std::size_t>(d / _delta); }
+
+    // Une nouvelle époque invalide d'un coup les distances de la requête précédente ;
+    // les marques de phase (_inFrontier, _removed) sont remises à zéro avant de déborder
+    void newEpoch() {
+        if (++_epoch == 0) {
+            std::fill(_reached.begin(), _reached.end(), 0);
+            _epoch = 1;
+        }
+        if (_stamp > std::numeric_limits<unsigned>::max() / 2) {
+            std::fill(_inFrontier.begin(), _inFrontier.end(), 0);
+            std::fill(_removed.begin(), _removed.end(), 0);
+            _stamp = 0;
+        }
+    }
+    void reach(Vertex v, double d, Vertex from) {
+        _reached[v] = _epoch;
+        _dist[v] = d;
+        _pred[v] = from;
+    }
+
+    std::vector<double> _dist;
+    std::vector<Vertex> _pred;
+    std::vector<unsigned> _reached;     // == _epoch : distance provisoire connue
+    std::vector<unsigned> _inFrontier;  // == numéro de phase : déjà dans la frontière
+    std::vector<unsigned> _removed;     // == numéro de seau : déjà sorti du seau courant
+    unsigned _epoch = 0;
+    unsigned _stamp = 0;                // dernier numéro de phase / seau utilisé
+
+    // état d'une exécution
+    const std::vector<Vertex>* _targets = nullptr;
+    double _delta = 1.0;
+    unsigned _threads = 1;
+    std::vector<Owner> _owners;
+    std::vector<std::vector<Request>> _outbox;  // [émetteur * threads + propriétaire]
+    std::unique_ptr<SpinBarrier> _barrier;
+    std::atomic<std::size_t> _lightNext{0}, _heavyNext{0};
+};
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef DIJKSTRA_WORKSPACE_HPP
+#define DIJKSTRA_WORKSPACE_HPP
+
+// Dijkstra avec espace de travail réutilisable : distances, prédécesseurs, états
+// et tas sont alloués une fois puis réutilisés d'une requête à l'autre
+// (remise à zéro en O(1) par numéro d'époque au lieu de remplir n cases)
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include "graph_types.hpp"
+#include "metrics.hpp"
+
+template <class G>
+class DijkstraWorkspace {
+public:
+    typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+
+    explicit DijkstraWorkspace(std::size_t n)
+        : _dist(n), _pred(n), _reached(n, 0), _settled(n, 0), _pending(n, 0) {
+        _heap.reserve(n);
+    }
+
+    // Dijkstra depuis source, arrêté dès que toutes les cibles ont leur distance définitive
+    // (sans cible, parcourt toute la composante)
+    void run(const G& g, Vertex source, const std::vector<Vertex>& targets) {
+        newEpoch();
+        std::size_t remaining = 0;
+        for (Vertex t : targets) {
+            if (_pending[t] != _epoch) {
+                _pending[t] = _epoch;
+                ++remaining;
+            }
+        }
+        const bool stopOnTargets = remaining > 0;
+        auto weights = get(&EdgeInfo::weight, g);
+
+        // compteurs locaux, publiés une fois à la fin (voir metrics.hpp)
+        std::uint64_t pushes = 1, pops = 0, settled = 0;
+        _heap.clear();
+        reach(source, 0.0, source);
+        pushHeap(0.0, source);
+        while (!_heap.empty()) {
+            std::pop_heap(_heap.begin(), _heap.end(), std::greater<HeapEntry>());
+            HeapEntry top = _heap.back();
+            _heap.pop_back();
+            ++pops;
+            Vertex u = top.second;
+            // entrée périmée : le sommet a été fixé avec une distance plus courte
+            if (_settled[u] == _epoch) continue;
+            _settled[u] = _epoch;
+            ++settled;
+            if (stopOnTargets && _pending[u] == _epoch && --remaining == 0) break;
+
+            typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+            for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+                Vertex v = target(*ei, g);
+                double d = top.first + get(weights, *ei);
+                if (_reached[v] != _epoch || d < _dist[v]) {
+                    reach(v, d, u);
+                    pushHeap(d, v);
+                    ++pushes;
+                }
+            }
+        }
+        if (Metrics::enabled()) {
+            Metrics::add(Counter::VerticesSettled, settled);
+            Metrics::add(Counter::HeapPushes, pushes);
+            Metrics::add(Counter::HeapPops, pops);
+        }
+    }
+
+    bool reached(Vertex v) const { return _reached[v] == _epoch; }
+    double distance(Vertex v) const { return _dist[v]; }
+    Vertex predecessor(Vertex v) const { return _pred[v]; }
+
+    // Chemin source -> target de la dernière requête, en IDs du CSV
+    PathResult path(const G& g, Vertex source, Vertex target) const {
+        if (!reached(target)) return PathResult(-1, {});
+        std::vector<NodeId> path;
+        auto ids = get(&NodeInfo::id, g);
+        for (Vertex v = target; ; v = _pred[v]) {
+            path.push_back(get(ids, v));
+            if (v == source) break;
+        }
+        std::reverse(path.begin(), path.end());
+        return PathResult(_dist[target], path);
+    }
+
+private:
+    typedef std::pair<double, Vertex> HeapEntry;
+
+    // Une nouvelle époque invalide d'un coup tous les états de la requête précédente
+    void newEpoch() {
+        if (++_epoch == 0) {
+            std::fill(_reached.begin(), _reached.end(), 0);
+            std::fill(_settled.begin(), _settled.end(), 0);
+            std::fill(_pending.begin(), _pending.end(), 0);
+            _epoch = 1;
+        }
+    }
+    void reach(Vertex v, double d, Vertex from) {
+        _reached[v] = _epoch;
+        _dist[v] = d;
+        _pred[v] = from;
+    }
+    void pushHeap(double d, Vertex v) {
+        _heap.push_back(HeapEntry(d, v));
+        std::push_heap(_heap.begin(), _heap.end(), std::greater<HeapEntry>());
+    }
+
+    std::vector<double> _dist;
+    std::vector<Vertex> _pred;
+    std::vector<unsigned> _reached;   // == _epoch : distance provisoire connue
+    std::vector<unsigned> _settled;   // == _epoch : distance définitive
+    std::vector<unsigned> _pending;   // == _epoch : cible pas encore atteinte
+    std::vector<HeapEntry> _heap;     // tas binaire avec entrées périmées (pas de decrease-key)
+    unsigned _epoch = 0;
+};
+
+#endif
@@ -0,0 +1,421 @@
+#ifndef DISTANCE_INDEX_HPP
+#define DISTANCE_INDEX_HPP
+
+// Index de distances persistant, construit une fois puis rechargé aux lancements suivants
+// - AllPairs (petits graphes) : un Dijkstra complet depuis chaque sommet (Johnson sans
+//   repondération, les poids sont positifs) ; on garde la matrice des distances et
+//   celle des prédécesseurs => distance en O(1), chemin en O(longueur)
+// - Landmarks (grands graphes, ALT) : distances exactes depuis quelques repères choisis
+//   par « le plus éloigné d'abord » ; une requête est un A* dont l'heuristique est
+//   max(|d(L,t) - d(L,v)|, distance euclidienne), admissible par inégalité triangulaire
+//   (graphe orienté : d(L,t) - d(L,v) seulement, seules les distances depuis L sont connues)
+// Le fichier binaire commence par un en-tête (magic, version, type, n, m, empreinte du
+// graphe, tailles des tableaux, somme de contrôle des données) : un index construit sur
+// un autre graphe est refusé au chargement, comme un fichier dont les tailles ne
+// correspondent pas au type (vérifiées avant toute allocation), dont la somme de contrôle
+// diffère ou dont un repère ou un prédécesseur sort du graphe.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include "graph_types.hpp"
+#include "dijkstra_workspace.hpp"
+#include "p2p_search.hpp"
+#include "delta_stepping.hpp"
+
+// Empreinte FNV-1a des extrémités et des poids, dans l'ordre de edges(g)
+// (plus l'orientation : mêmes arêtes orientées ou non ne donnent pas les mêmes distances)
+template <class G>
+std::uint64_t graphFingerprint(const G& g) {
+    std::uint64_t h = 1469598103934665603ULL;
+    auto mix = [&h](const void* data, std::size_t len) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < len; ++i) {
+            h ^= p[i];
+            h *= 1099511628211ULL;
+        }
+    };
+    if (boost::is_directed_graph<G>::value) mix("->", 2);
+    auto weights = get(&EdgeInfo::weight, g);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // edge_iterator orienté de Boost, voir graph_types.hpp
+    typename boost::graph_traits<G>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = edges(g); ei != ei_end; ++ei) {
+        std::uint64_t s = source(*ei, g), t = target(*ei, g);
+        double w = get(weights, *ei);
+        mix(&s, sizeof s);
+        mix(&t, sizeof t);
+        mix(&w, sizeof w);
+    }
+#pragma GCC diagnostic pop
+    return h;
+}
+
+class DistanceIndex {
+public:
+    enum Kind : std::uint32_t { AllPairs = 1, Landmarks = 2 };
+
+    // au-delà, la matrice n x n (12 octets par case) devient trop grosse
+    static constexpr std::size_t kAllPairsMaxVertices = 2048;
+
+    DistanceIndex() {}
+
+    Kind kind() const { return _kind; }
+    std::size_t landmarkCount() const { return _landmarks.size(); }
+    bool empty() const { return _n == 0; }
+
+    // Construit l'index ; kind = 0 => choix automatique selon la taille du graphe. AllPairs
+    // demandé au-delà de kAllPairsMaxVertices sommets : repères ALT à la place (voir kind())
+    // threads > 1 (0 = tous les coeurs) : distances des repères par delta-stepping parallèle
+    template <class G>
+    void build(const G& g, std::uint32_t kind = 0, std::size_t landmarks = 16, unsigned threads = 1) {
+        typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+        _n = num_vertices(g);
+        _m = num_edges(g);
+        _fingerprint = graphFingerprint(g);
+        _kind = kind ? static_cast<Kind>(kind) : (_n <= kAllPairsMaxVertices ? AllPairs : Landmarks);
+        if (_kind == AllPairs && _n > kAllPairsMaxVertices) _kind = Landmarks;
+        _dist.clear();
+        _pred.clear();
+        _landmarks.clear();
+        const std::vector<Vertex> noTarget;
+
+        if (_kind == AllPairs) {
+            DijkstraWorkspace<G> ws(_n);
+            _dist.assign(_n * _n, kInfinity);
+            _pred.assign(_n * _n, kNoPred);
+            for (std::size_t s = 0; s < _n; ++s) {
+                ws.run(g, s, noTarget);
+                for (std::size_t v = 0; v < _n; ++v) {
+                    if (!ws.reached(v)) continue;
+                    _dist[s * _n + v] = ws.distance(v);
+                    _pred[s * _n + v] = static_cast<std::uint32_t>(ws.predecessor(v));
+                }
+            }
+            return;
+        }
+
+        // delta-stepping : mêmes distances que Dijkstra, donc même index
+        if (threads != 1) {
+            DeltaSteppingWorkspace<G> ws(_n);
+            const double delta = deltaSteppingWidth(g);
+            buildLandmarks(ws, landmarks, [&](std::size_t s) { ws.run(g, s, noTarget, threads, delta); });
+        } else {
+            DijkstraWorkspace<G> ws(_n);
+            buildLandmarks(ws, landmarks, [&](std::size_t s) { ws.run(g, s, noTarget); });
+        }
+    }
+
+    bool save(const std::string& filename) const {
+        std::FILE* f = std::fopen(filename.c_str(), "wb");
+        if (!f) return false;
+        Header h = makeHeader();
+        bool ok = std::fwrite(&h, sizeof h, 1, f) == 1 &&
+                  writeArray(f, _landmarks) && writeArray(f, _dist) && writeArray(f, _pred);
+        return std::fclose(f) == 0 && ok;
+    }
+
+    // Recharge un index et vérifie qu'il correspond bien au graphe chargé
+    template <class G>
+    bool load(const std::string& filename, const G& g) {
+        std::FILE* f = std::fopen(filename.c_str(), "rb");
+        if (!f) {
+            std::cerr << "Erreur : Impossible d'ouvrir l'index " << filename << std::endl;
+            return false;
+        }
+        Header h;
+        bool ok = std::fread(&h, sizeof h, 1, f) == 1 && std::equal(h.magic, h.magic + 8, kMagic) &&
+                  h.version == kVersion && (h.kind == AllPairs || h.kind == Landmarks);
+        if (ok && (h.vertices != num_vertices(g) || h.edges != num_edges(g) || h.fingerprint != graphFingerprint(g))) {
+            std::cerr << "Erreur : l'index " << filename << " a été construit sur un autre graphe" << std::endl;
+            std::fclose(f);
+            return false;
+        }
+        if (ok) {
+            _kind = static_cast<Kind>(h.kind);
+            _n = h.vertices;
+            _m = h.edges;
+            _fingerprint = h.fingerprint;
+            ok = sizesValid(h) && remainingBytes(f) == h.landmarks * sizeof(std::uint32_t) +
+                 h.distCount * sizeof(double) + h.predCount * sizeof(std::uint32_t) &&
+                 readArray(f, _landmarks, h.landmarks) && readArray(f, _dist, h.distCount) &&
+                 readArray(f, _pred, h.predCount) && dataChecksum() == h.dataChecksum && valuesValid();
+        }
+        std::fclose(f);
+        if (!ok) {
+            std::cerr << "Erreur : index " << filename << " invalide" << std::endl;
+            _n = 0;
+            _landmarks.clear();
+            _dist.clear();
+            _pred.clear();
+        }
+        return ok;
+    }
+
+    // Espace de travail de la recherche ALT (un par thread)
+    template <class G>
+    class Workspace {
+    public:
+        explicit Workspace(std::size_t n) : _dist(n), _pred(n), _reached(n, 0), _settled(n, 0) {}
+    private:
+        friend class DistanceIndex;
+        typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+        typedef std::pair<double, Vertex> HeapEntry;
+        std::vector<double> _dist;
+        std::vector<Vertex> _pred;
+        std::vector<unsigned> _reached;
+        std::vector<unsigned> _settled;
+        std::vector<HeapEntry> _heap;
+        unsigned _epoch = 0;
+    };
+
+    // Même convention que shortestPath : IDs du CSV (voir nodeIndex), {-1, {}} si pas de chemin
+    template <class G>
+    PathResult query(const G& g, NodeId startNodeId, NodeId endNodeId, Workspace<G>& ws) const {
+        typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+        const std::size_t start = nodeIndex(g, startNodeId);
+        const std::size_t end = nodeIndex(g, endNodeId);
+        if (start >= _n || end >= _n) {
+            std::cerr << "Erreur : Indices de nœuds invalides." << std::endl;
+            return PathResult(-1, {});
+        }
+        if (_kind == AllPairs) {
+            const std::size_t row = start * _n;
+            if (_dist[row + end] == kInfinity) return PathResult(-1, {});
+            std::vector<NodeId> path;
+            auto ids = get(&NodeInfo::id, g);
+            // au plus n sommets : un index dont les prédécesseurs bouclent ne bloque pas la requête
+            for (std::size_t v = end; ; v = _pred[row + v]) {
+                if (v >= _n || path.size() == _n) {
+                    std::cerr << "Erreur : index de distances incohérent" << std::endl;
+                    return PathResult(-1, {});
+                }
+                path.push_back(get(ids, static_cast<Vertex>(v)));
+                if (v == start) break;
+            }
+            std::reverse(path.begin(), path.end());
+            return PathResult(_dist[row + end], path);
+        }
+        return altSearch(g, static_cast<Vertex>(start), static_cast<Vertex>(end), ws);
+    }
+
+    // Distance seule (AllPairs : lecture directe de la matrice)
+    template <class G>
+    double distance(const G& g, NodeId startNodeId, NodeId endNodeId, Workspace<G>& ws) const {
+        const std::size_t start = nodeIndex(g, startNodeId);
+        const std::size_t end = nodeIndex(g, endNodeId);
+        if (_kind == AllPairs && start < _n && end < _n) {
+            double d = _dist[start * _n + end];
+            return d == kInfinity ? -1 : d;
+        }
+        return query(g, startNodeId, endNodeId, ws).first;
+    }
+
+private:
+    static constexpr double kInfinity = std::numeric_limits<double>::infinity();
+    static constexpr std::uint32_t kNoPred = 0xFFFFFFFFu;
+    static constexpr std::uint32_t kVersion = 2;  // 2 : somme de contrôle des données
+    static constexpr char kMagic[8] = { 'G', 'C', 'P', 'P', 'I', 'D', 'X', '\0' };
+
+    // Repères : le premier est le sommet 0, chaque suivant est le plus éloigné
+    // des repères déjà choisis (un sommet d'une autre composante compte comme infini) ;
+    // search(s) calcule dans ws les distances depuis s
+    template <class Workspace, class Search>
+    void buildLandmarks(const Workspace& ws, std::size_t landmarks, Search search) {
+        landmarks = std::min(landmarks, _n);
+        std::vector<double> nearest(_n, kInfinity);
+        std::size_t next = 0;
+        for (std::size_t k = 0; k < landmarks; ++k) {
+            _landmarks.push_back(static_cast<std::uint32_t>(next));
+            search(next);
+            for (std::size_t v = 0; v < _n; ++v) {
+                double d = ws.reached(v) ? ws.distance(v) : kInfinity;
+                _dist.push_back(d);
+                nearest[v] = std::min(nearest[v], d);
+            }
+            nearest[next] = -1.0;  // déjà repère
+            next = std::max_element(nearest.begin(), nearest.end()) - nearest.begin();
+            if (nearest[next] < 0) break;
+        }
+    }
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t kind;
+        std::uint64_t vertices;
+        std::uint64_t edges;
+        std::uint64_t fingerprint;
+        std::uint64_t landmarks;
+        std::uint64_t distCount;
+        std::uint64_t predCount;
+        std::uint64_t dataChecksum;
+    };
+
+    Header makeHeader() const {
+        Header h;
+        std::copy(kMagic, kMagic + 8, h.magic);
+        h.version = kVersion;
+        h.kind = _kind;
+        h.vertices = _n;
+        h.edges = _m;
+        h.fingerprint = _fingerprint;
+        h.landmarks = _landmarks.size();
+        h.distCount = _dist.size();
+        h.predCount = _pred.size();
+        h.dataChecksum = dataChecksum();
+        return h;
+    }
+
+    // Tailles annoncées par l'en-tête, cohérentes avec le type et n (avant toute allocation)
+    static bool sizesValid(const Header& h) {
+        if (h.kind == AllPairs) {
+            return h.vertices <= kAllPairsMaxVertices && h.landmarks == 0 &&
+                   h.distCount == h.vertices * h.vertices && h.predCount == h.distCount;
+        }
+        return h.landmarks <= h.vertices && h.distCount == h.landmarks * h.vertices && h.predCount == 0;
+    }
+
+    // Repères et prédécesseurs désignent des sommets du graphe (kNoPred : non atteint)
+    bool valuesValid() const {
+        for (std::uint32_t l : _landmarks) {
+            if (l >= _n) return false;
+        }
+        for (std::uint32_t p : _pred) {
+            if (p >= _n && p != kNoPred) return false;
+        }
+        return true;
+    }
+
+    // FNV-1a par mots de 64 bits sur les trois tableaux
+    std::uint64_t dataChecksum() const {
+        std::uint64_t h = 1469598103934665603ULL;
+        auto mix = [&h](const void* data, std::size_t len) {
+            const char* p = static_cast<const char*>(data);
+            std::size_t i = 0;
+            for (; i + 8 <= len; i += 8) {
+                std::uint64_t w;
+                std::memcpy(&w, p + i, 8);
+                h = (h ^ w) * 1099511628211ULL;
+            }
+            for (; i < len; ++i) h = (h ^ static_cast<unsigned char>(p[i])) * 1099511628211ULL;
+        };
+        mix(_landmarks.data(), _landmarks.size() * sizeof(std::uint32_t));
+        mix(_dist.data(), _dist.size() * sizeof(double));
+        mix(_pred.data(), _pred.size() * sizeof(std::uint32_t));
+        return h;
+    }
+
+    template <class T>
+    static bool writeArray(std::FILE* f, const std::vector<T>& v) {
+        return v.empty() || std::fwrite(v.data(), sizeof(T), v.size(), f) == v.size();
+    }
+    // Octets restant à lire : les tableaux annoncés doivent remplir exactement la fin du fichier
+    static std::uint64_t remainingBytes(std::FILE* f) {
+        long at = std::ftell(f);
+        if (at < 0 || std::fseek(f, 0, SEEK_END) != 0) return 0;
+        long end = std::ftell(f);
+        if (end < at || std::fseek(f, at, SEEK_SET) != 0) return 0;
+        return static_cast<std::uint64_t>(end - at);
+    }
+    template <class T>
+    static bool readArray(std::FILE* f, std::vector<T>& v, std::uint64_t count) {
+        v.resize(count);
+        return v.empty() || std::fread(v.data(), sizeof(T), v.size(), f) == v.size();
+    }
+
+    // Borne inférieure de d(v, t) : inégalité triangulaire sur chaque repère
+    // et distance à vol d'oiseau, réduites comme EuclideanHeuristic pour les arrondis
+    template <class G>
+    double lowerBound(std::size_t v, std::size_t t, const EuclideanHeuristic<G>& euclid) const {
+        const bool directed = boost::is_directed_graph<G>::value;
+        double h = euclid(v);
+        for (std::size_t k = 0; k < _landmarks.size(); ++k) {
+            const double* d = &_dist[k * _n];
+            if (d[v] == kInfinity || d[t] == kInfinity) continue;
+            h = std::max(h, (directed ? d[t] - d[v] : std::fabs(d[t] - d[v])) * (1.0 - 1e-12));
+        }
+        return h;
+    }
+
+    // A* guidé par les repères, arrêté dès que la cible sort du tas
+    template <class G>
+    PathResult altSearch(const G& g, typename boost::graph_traits<G>::vertex_descriptor source,
+                         typename boost::graph_traits<G>::vertex_descriptor goal, Workspace<G>& ws) const {
+        typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+        typedef typename Workspace<G>::HeapEntry HeapEntry;
+        // un repère qui atteint l'un mais pas l'autre : composantes différentes
+        // (orienté : un repère qui atteint la source atteint aussi tout ce qu'elle atteint)
+        for (std::size_t k = 0; k < _landmarks.size(); ++k) {
+            const double* d = &_dist[k * _n];
+            bool unreachable = boost::is_directed_graph<G>::value ? d[source] != kInfinity && d[goal] == kInfinity
+                                                                  : (d[source] == kInfinity) != (d[goal] == kInfinity);
+            if (unreachable) return PathResult(-1, {});
+        }
+        if (++ws._epoch == 0) {
+            std::fill(ws._reached.begin(), ws._reached.end(), 0);
+            std::fill(ws._settled.begin(), ws._settled.end(), 0);
+            ws._epoch = 1;
+        }
+        const unsigned epoch = ws._epoch;
+        EuclideanHeuristic<G> euclid(g, goal);
+        auto weights = get(&EdgeInfo::weight, g);
+
+        ws._heap.clear();
+        ws._reached[source] = epoch;
+        ws._dist[source] = 0.0;
+        ws._pred[source] = source;
+        ws._heap.push_back(HeapEntry(lowerBound(source, goal, euclid), source));
+        bool found = false;
+        while (!ws._heap.empty()) {
+            std::pop_heap(ws._heap.begin(), ws._heap.end(), std::greater<HeapEntry>());
+            Vertex u = ws._heap.back().second;
+            ws._heap.pop_back();
+            if (ws._settled[u] == epoch) continue;
+            ws._settled[u] = epoch;
+            if (u == goal) {
+                found = true;
+                break;
+            }
+            typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+            for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+                Vertex v = target(*ei, g);
+                double d = ws._dist[u] + get(weights, *ei);
+                if (ws._reached[v] != epoch || d < ws._dist[v]) {
+                    ws._reached[v] = epoch;
+                    ws._dist[v] = d;
+                    ws._pred[v] = u;
+                    ws._heap.push_back(HeapEntry(d + lowerBound(v, goal, euclid), v));
+                    std::push_heap(ws._heap.begin(), ws._heap.end(), std::greater<HeapEntry>());
+                }
+            }
+        }
+        if (!found) return PathResult(-1, {});
+        std::vector<Vertex> vertices;
+        for (Vertex v = goal; ; v = ws._pred[v]) {
+            vertices.push_back(v);
+            if (v == source) break;
+        }
+        std::reverse(vertices.begin(), vertices.end());
+        return toPathResult(g, vertices);
+    }
+
+    Kind _kind = AllPairs;
+    std::size_t _n = 0;
+    std::size_t _m = 0;
+    std::uint64_t _fingerprint = 0;
+    std::vector<std::uint32_t> _landmarks;
+    std::vector<double> _dist;           // AllPairs : n x n ; Landmarks : k x n
+    std::vector<std::uint32_t> _pred;    // AllPairs uniquement : n x n
+};
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef DYNAMIC_GRAPH_HPP
+#define DYNAMIC_GRAPH_HPP
+
+// Mises à jour incrémentales d'un graphe chargé (adjacency_list) : insertions et
+// suppressions d'arêtes par lots, sans recharger les CSV
+// - connectivité : l'union-find est complété à chaque insertion ; une suppression ne
+//   peut couper une composante que si l'arête n'a ni arête parallèle ni autre chemin
+//   court entre ses extrémités (BFS borné) ; sinon l'union-find est marqué à
+//   reconstruire, une seule fois au prochain besoin même après plusieurs suppressions
+// - cycles : E > V - C (voir cycle_detection.hpp)
+// - chemins : les résultats déjà calculés sont gardés par paire ; une suppression
+//   n'invalide que les chemins qui passent par l'arête, une insertion seulement ceux
+//   que l'arête pourrait raccourcir (borne inférieure euclidienne de d(s, a) et d(b, t))
+//   ou relier ; les paires invalidées sont recalculées ensemble au prochain appel.
+//   En cas d'égalité exacte de longueur, le chemin existant est conservé.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+#include "graph_types.hpp"
+#include "soa_properties.hpp"
+#include "connected_components.hpp"
+#include "cycle_detection.hpp"
+#include "path_engine.hpp"
+
+class DynamicGraph {
+public:
+    // Bilan d'un lot de mises à jour
+    struct UpdateStats {
+        std::size_t applied = 0;      // arêtes réellement ajoutées / retirées
+        std::size_t ignored = 0;      // suppressions d'arêtes absentes
+        std::size_t invalidated = 0;  // chemins en cache à recalculer
+        double milliseconds = 0.0;
+    };
+
+    // Taille du BFS qui cherche un autre chemin entre les extrémités d'une arête supprimée
+    static constexpr std::size_t kSplitCheckBudget = 4096;
+
+    explicit DynamicGraph(Graph& g, unsigned threads = 1)
+        : _g(g), _threads(threads), _mark(boost::num_vertices(g), 0) {
+        rebuildComponents();
+    }
+
+    // Arêtes à ajouter, indices 0-based et poids déjà calculés (voir computeEdgeWeights)
+    UpdateStats insertEdges(const EdgeBatch& batch) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        UpdateStats stats;
+        auto xs = boost::get(&NodeInfo::x, _g);
+        auto ys = boost::get(&NodeInfo::y, _g);
+        auto zs = boost::get(&NodeInfo::z, _g);
+        auto euclid = [&](std::size_t a, std::size_t b) {
+            double dx = xs[a] - xs[b], dy = ys[a] - ys[b], dz = zs[a] - zs[b];
+            return std::sqrt(dx*dx + dy*dy + dz*dz) * (1.0 - 1e-12);
+        };
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            std::size_t a = batch.source[i], b = batch.target[i];
+            double w = batch.weight[i];
+            Edge e = boost::add_edge(a, b, _g).first;
+            _g[e].weight = w;
+            _g[e].inPath = false;
+            ++stats.applied;
+            if (!_componentsDirty && _unionFind.unite(a, b)) --_componentCount;
+
+            // un chemin s -> t ne peut raccourcir que si s -> a -> b -> t (ou s -> b -> a -> t)
+            // peut être plus court que lui ; une paire sans chemin peut devenir reliée
+            for (auto it = _paths.begin(); it != _paths.end(); ) {
+                std::size_t s = nodeIndex(_g, it->first.first), t = nodeIndex(_g, it->first.second);
+                double length = it->second.first;
+                bool affected = length < 0 ||
+                    std::min(euclid(s, a) + euclid(b, t), euclid(s, b) + euclid(a, t)) + w < length;
+                if (affected) {
+                    it = _paths.erase(it);
+                    ++stats.invalidated;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        stats.milliseconds = elapsedMs(t0);
+        return stats;
+    }
+
+    // Arêtes à retirer (une seule occurrence par ligne s'il y a des arêtes parallèles)
+    UpdateStats deleteEdges(const EdgeBatch& batch) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        UpdateStats stats;
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            std::size_t a = batch.source[i], b = batch.target[i];
+            Edge e;
+            bool exists;
+            boost::tie(e, exists) = boost::edge(a, b, _g);
+            if (!exists) {
+                ++stats.ignored;
+                continue;
+            }
+            boost::remove_edge(e, _g);
+            ++stats.applied;
+
+            // même poids (mêmes extrémités) : une arête parallèle restante remplace l'arête
+            // dans les chemins comme dans la connectivité
+            if (boost::edge(a, b, _g).second) continue;
+            if (!_componentsDirty && a != b && !reachableWithin(a, b, kSplitCheckBudget)) _componentsDirty = true;
+
+            for (auto it = _paths.begin(); it != _paths.end(); ) {
+                if (pathUsesEdge(it->second.second, a, b)) {
+                    it = _paths.erase(it);
+                    ++stats.invalidated;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        stats.milliseconds = elapsedMs(t0);
+        return stats;
+    }
+
+    std::size_t componentCount() {
+        if (_componentsDirty) rebuildComponents();
+        return _componentCount;
+    }
+    bool connected() { return componentCount() == 1; }
+    bool hasCycle() { return boost::num_edges(_g) + componentCount() > boost::num_vertices(_g); }
+
+    // Étiquetage complet (numérotation recalculée à la demande)
+    ComponentLabels components() {
+        if (_componentsDirty) rebuildComponents();
+        ComponentLabels labels;
+        labelComponents(_unionFind, boost::num_vertices(_g), 1, labels);
+        return labels;
+    }
+
+    // Chemins pour ces paires (IDs du CSV) : réutilisés s'ils sont encore valides,
+    // les autres sont recalculés en un seul lot ; recomputed = nombre de paires recalculées
+    std::vector<PathResult> paths(const std::vector<NodePair>& nodePairs, unsigned threads,
+                                  PathMode mode, std::size_t* recomputed = nullptr) {
+        const std::size_t n = boost::num_vertices(_g);
+        std::vector<NodePair> missing;
+        for (const auto& p : nodePairs) {
+            bool valid = nodeIndex(_g, p.first) < n && nodeIndex(_g, p.second) < n;
+            if (valid && !_paths.count(p)) missing.push_back(p);
+        }
+        std::sort(missing.begin(), missing.end());
+        missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+        if (recomputed) *recomputed = missing.size();
+        if (!missing.empty()) {
+            std::vector<PathResult> fresh = PathQueryEngine<Graph>(_g).run(missing, threads, mode);
+            for (std::size_t i = 0; i < missing.size(); ++i) _paths[missing[i]] = fresh[i];
+        }
+
+        // paires invalides : même message et même résultat que PathQueryEngine
+        std::vector<PathResult> results;
+        for (const auto& p : nodePairs) {
+            auto it = _paths.find(p);
+            if (it != _paths.end()) {
+                results.push_back(it->second);
+            } else {
+                results.push_back(PathQueryEngine<Graph>(_g).run(std::vector<NodePair>(1, p))[0]);
+            }
+        }
+        return results;
+    }
+
+private:
+    static double elapsedMs(std::chrono::high_resolution_clock::time_point t0) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+
+    void rebuildComponents() {
+        const std::size_t n = boost::num_vertices(_g);
+        unsigned threads = componentThreads(n, _threads);
+        _unionFind.reset(n);
+        uniteAllEdges(_g, _unionFind, threads);
+        _componentCount = 0;
+        for (std::size_t v = 0; v < n; ++v) {
+            if (_unionFind.find(v) == v) ++_componentCount;
+        }
+        _componentsDirty = false;
+    }
+
+    // BFS depuis a, arrêté dès que b est atteint ou après `budget` sommets visités ;
+    // faux si b n'a pas été trouvé (composante coupée ou budget épuisé)
+    bool reachableWithin(std::size_t a, std::size_t b, std::size_t budget) {
+        if (++_epoch == 0) {
+            std::fill(_mark.begin(), _mark.end(), 0);
+            _epoch = 1;
+        }
+        _queue.clear();
+        _queue.push_back(a);
+        _mark[a] = _epoch;
+        for (std::size_t head = 0; head < _queue.size() && head < budget; ++head) {
+            boost::graph_traits<Graph>::out_edge_iterator ei, ei_end;
+            for (boost::tie(ei, ei_end) = boost::out_edges(_queue[head], _g); ei != ei_end; ++ei) {
+                std::size_t v = boost::target(*ei, _g);
+                if (v == b) return true;
+                if (_mark[v] == _epoch) continue;
+                _mark[v] = _epoch;
+                _queue.push_back(v);
+            }
+        }
+        return false;
+    }
+
+    // Le chemin (IDs) emprunte-t-il l'arête a - b (indices) dans un sens ou l'autre ?
+    bool pathUsesEdge(const std::vector<NodeId>& path, std::size_t a, std::size_t b) const {
+        const NodeId ia = _g[a].id, ib = _g[b].id;
+        for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+            if ((path[i] == ia && path[i + 1] == ib) || (path[i] == ib && path[i + 1] == ia)) return true;
+        }
+        return false;
+    }
+
+    Graph& _g;
+    unsigned _threads;
+    ConcurrentUnionFind _unionFind;
+    std::size_t _componentCount = 0;
+    bool _componentsDirty = false;
+    std::map<NodePair, PathResult> _paths;  // chemins encore valides, par paire d'IDs
+    std::vector<std::uint32_t> _mark;       // époques du BFS de suppression
+    std::uint32_t _epoch = 0;
+    std::vector<std::size_t> _queue;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef GRAPH_ALGORITHMS_HPP
+#define GRAPH_ALGORITHMS_HPP
+
+// Questions posées au graphe par le rapport : connectivité, cycle, plus court chemin.
+// Les fonctions sont des templates : elles acceptent l'adjacency_list (Graph) comme le
+// graphe figé CsrGraph (voir csr_graph.hpp)
+
+#include <utility>
+#include <vector>
+#include "graph_types.hpp"
+#include "connected_components.hpp"
+#include "cycle_detection.hpp"
+#include "path_engine.hpp"
+#include "spatial_index.hpp"
+
+// Fonction pour vérifier si le graphe est connecté
+// (union-find parallèle, voir connected_components.hpp ; connexité faible en orienté)
+template <class G>
+bool isConnected(const G& g, unsigned threads = 1) {
+    return connectedComponentLabels(g, threads).count() == 1;
+}
+
+// Fonction pour détecter les cycles dans le graphe
+// avec les composantes déjà calculées la réponse est immédiate (E > V - C),
+// sinon parcours en profondeur arrêté au premier cycle (voir cycle_detection.hpp) ;
+// toujours le parcours pour un graphe orienté (cycle orienté)
+template <class G>
+bool hasCycle(const G& g, const ComponentLabels* components = nullptr) {
+    if (components && !boost::is_directed_graph<G>::value) return hasCycleByCount(g, *components);
+    return !findCycle(g).empty();
+}
+
+// Plus courts chemins d'une source vers plusieurs cibles avec un seul Dijkstra,
+// arrêté dès que toutes les cibles sont fixées ; résultats dans l'ordre de targetIds
+template <class G>
+std::vector<PathResult> shortestPathsFrom(const G& g, NodeId startNodeId, const std::vector<NodeId>& targetIds) {
+    std::vector<NodePair> nodePairs;
+    for (NodeId id : targetIds) nodePairs.push_back(std::make_pair(startNodeId, id));
+    return PathQueryEngine<G>(g).run(nodePairs);
+}
+
+// Fonction pour calculer le chemin le plus court entre deux nœuds
+// mode A* ou bidirectionnel : recherche point à point (voir p2p_search.hpp)
+// avec un index de distances chargé, la requête est répondue par l'index
+// threads ne sert qu'au mode delta-stepping (une seule recherche, partagée entre les threads)
+template <class G>
+PathResult shortestPath(const G& g, NodeId startNodeId, NodeId endNodeId, PathMode mode = PathMode::Dijkstra,
+                        const DistanceIndex* index = nullptr, unsigned threads = 1) {
+    if (mode == PathMode::Dijkstra && !index) {
+        return shortestPathsFrom(g, startNodeId, std::vector<NodeId>(1, endNodeId))[0];
+    }
+    return PathQueryEngine<G>(g, index).run(std::vector<NodePair>(1, std::make_pair(startNodeId, endNodeId)),
+                                            threads, mode)[0];
+}
+
+// Plus court chemin entre deux positions : chaque extrémité est le nœud le plus proche
+// de la position donnée (index spatial, voir spatial_index.hpp)
+template <class G>
+PathResult shortestPath(const G& g, const SpatialIndex& spatial, const Point3& from, const Point3& to,
+                        PathMode mode = PathMode::Dijkstra, const DistanceIndex* index = nullptr, unsigned threads = 1) {
+    if (spatial.empty()) return PathResult(-1, {});
+    auto ids = get(&NodeInfo::id, g);
+    return shortestPath(g, get(ids, spatial.nearest(from).vertex), get(ids, spatial.nearest(to).vertex), mode, index, threads);
+}
+
+#endif
@@ -0,0 +1,454 @@
+#ifndef GRAPH_ANALYSIS_HPP
+#define GRAPH_ANALYSIS_HPP
+
+// Analyse d'un graphe chargé : rapport, illustration, paths.csv, components.csv, index
+// de distances et serveur de requêtes. Les fonctions sont des templates sur le graphe :
+// adjacency_list (Graph, DirectedGraph) ou CSR figé (BasicCsrGraph<Config>, voir
+// graph_config.hpp). runAnalysis est instancié une fois par configuration, dans
+// analysis_undirected.cpp et analysis_directed.cpp, et non dans chaque unité qui l'appelle.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <utility>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include "graph_types.hpp"
+#include "graph_config.hpp"
+#include "csr_graph.hpp"
+#include "path_engine.hpp"
+#include "graph_io.hpp"
+#include "graph_algorithms.hpp"
+#include "connected_components.hpp"
+#include "cycle_detection.hpp"
+#include "graph_summary.hpp"
+#include "distance_index.hpp"
+#include "query_server.hpp"
+#include "metrics.hpp"
+#include "graph_render.hpp"
+#include "spatial_index.hpp"
+#include "centrality.hpp"
+
+// Répartition des tailles de composantes par puissances de 2 : [1], [2, 3], [4, 7]...
+inline void printComponentStats(const ComponentLabels& labels) {
+    std::cout << "Nombre de composantes connexes: " << labels.count() << std::endl;
+    if (labels.count() < 2) return;
+    std::cout << "Taille de la plus grande composante: " << labels.largest() << std::endl;
+    std::vector<size_t> buckets = componentSizeBuckets(labels);
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        if (buckets[b] == 0) continue;
+        size_t low = size_t(1) << b, high = (size_t(2) << b) - 1;
+        std::cout << "    taille " << low;
+        if (high > low) std::cout << "-" << high;
+        std::cout << ": " << buckets[b] << " composante(s)" << std::endl;
+    }
+}
+
+// Répartition des degrés : une ligne par degré s'il y en a peu de différents, sinon par
+// puissances de 2 comme les composantes ([1], [2, 3], [4, 7]...) ; le degré de chaque
+// nœud est écrit dans centrality.csv plutôt qu'à l'écran
+inline void printDegreeHistogram(const GraphSummary& summary) {
+    const std::vector<size_t>& histogram = summary.degreeHistogram;
+    size_t distinct = 0, total = 0;
+    for (size_t d = 0; d < histogram.size(); ++d) {
+        if (histogram[d] > 0) ++distinct;
+        total += d * histogram[d];
+    }
+    if (summary.vertices > 0) {
+        std::cout << "Degré moyen: " << std::fixed << std::setprecision(2) << double(total) / summary.vertices << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::setprecision(6);
+    }
+    std::cout << "Répartition des degrés:" << std::endl;
+    if (distinct <= 16) {
+        for (size_t d = 0; d < histogram.size(); ++d) {
+            if (histogram[d] > 0) std::cout << "    degré " << d << ": " << histogram[d] << " nœud(s)" << std::endl;
+        }
+        return;
+    }
+    if (!histogram.empty() && histogram[0] > 0) std::cout << "    degré 0: " << histogram[0] << " nœud(s)" << std::endl;
+    for (size_t low = 1; low < histogram.size(); low *= 2) {
+        size_t high = std::min(2 * low - 1, histogram.size() - 1), count = 0;
+        for (size_t d = low; d <= high; ++d) count += histogram[d];
+        if (count == 0) continue;
+        std::cout << "    degré " << low;
+        if (high > low) std::cout << "-" << high;
+        std::cout << ": " << count << " nœud(s)" << std::endl;
+    }
+}
+
+// Fonction pour marquer les arêtes du chemin (pour l'illustration)
+template <class G>
+void markPathEdges(G& g, const std::vector<NodeId>& path) {
+    // Réinitialiser toutes les arêtes
+    auto inPath = get(&EdgeInfo::inPath, g);
+    typename boost::graph_traits<G>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = edges(g); ei != ei_end; ++ei) {
+        put(inPath, *ei, false);
+    }
+    
+    // Marquer les arêtes du chemin
+    for (size_t i = 0; i < path.size() - 1; ++i) {
+        size_t u = nodeIndex(g, path[i]);  // Convertir l'ID en indice
+        size_t v = nodeIndex(g, path[i + 1]);
+        
+        // Trouver l'arête entre u et v
+        typename boost::graph_traits<G>::edge_descriptor e;
+        bool exists;
+        boost::tie(e, exists) = edge(u, v, g);
+        if (exists) {
+            put(inPath, e, true);
+        }
+    }
+}
+
+// Fonction pour générer une illustration du graphe (sortie Graphviz DOT)
+// vues réduites et positions fixes pour les grands graphes : voir graph_render.hpp
+// pour un PNG, le DOT est écrit à côté (graph.png -> graph.dot) puis rendu par dot ou neato -n
+template <class G>
+void generateGraphImage(const G& g, const std::string& filename, const RenderOptions& render = RenderOptions()) {
+    std::string pattern = ".png";
+    bool png = filename.find(pattern) != std::string::npos;
+    std::string dotFilename = png ? filename.substr(0, filename.rfind(pattern)) + ".dot" : filename;
+    const size_t n = num_vertices(g);
+    
+    // la mise en page de dot ne termine pas sur un grand graphe : seul le voisinage du chemin est dessiné
+    RenderOptions view = render;
+    if (view.view == RenderView::Auto && png && n > view.maxNodes) {
+        view.view = RenderView::Route;
+        view.positions = true;
+        std::cout << "Graphe de " << n << " nœuds : illustration limitée au voisinage du chemin "
+                  << "(--render=full pour tout dessiner)" << std::endl;
+    }
+    bool full = view.view == RenderView::Auto || view.view == RenderView::Full;
+    
+    // Écrire le graphe au format DOT (ID des nœuds, poids et chemin en rouge, voir writeGraphDot)
+    {
+        ScopedPhase phase(Phase::WriteDot);
+        size_t drawn = n;
+        bool ok = full && !view.positions ? writeGraphDot(g, dotFilename) : writeGraphView(g, view, dotFilename, drawn);
+        if (!ok) {
+            std::cerr << "Erreur : Impossible de créer le fichier DOT." << std::endl;
+            return;
+        }
+        if (!full) {
+            std::cout << "Vue " << renderViewName(view.view) << " : " << drawn
+                      << (view.view == RenderView::Components ? " composante(s)" : " nœud(s)")
+                      << " dessiné(s) sur " << n << " nœuds" << std::endl;
+        }
+    }
+    std::string renderer = view.positions ? "neato -n -Tpng " : "dot -Tpng ";
+    if (!png) { // test si l'utilisateur demande un PNG
+    std::cout << "Fichier DOT généré : " << filename << std::endl;
+    std::cout << "Pour visualiser le graphe, utilisez Graphviz avec la commande :" << std::endl;
+    std::cout << renderer << filename << " -o graph.png" << std::endl;
+    } else {
+    // Command to generate a PNG from a DOT file
+    ScopedPhase phase(Phase::RenderImage);
+    std::string command = renderer + dotFilename + " -o " + filename;
+    int result = system(command.c_str());
+
+    // Check the result for success or failure
+    if (result == 0) {
+        std::cout << "png successfully!" << std::endl;
+    } else {
+        std::cerr << "Error making png!" << std::endl;
+    }
+    std::cout << "PNG réalsier" << std::endl;
+    }
+}
+
+// Fonction principale pour générer le rapport d'analyse du graphe
+// les degrés, la connectivité et la présence de cycle viennent de l'analyse
+// fusionnée (graph_summary.hpp), calculée ici si elle n'est pas fournie
+template <class G>
+void generateGraphReport(G& g, NodeId start, NodeId end, PathMode mode = PathMode::Dijkstra,
+                         const DistanceIndex* index = nullptr, const GraphSummary* summary = nullptr,
+                         unsigned threads = 1) {
+    GraphSummary localSummary;
+    if (!summary) {
+        localSummary = summarizeGraph(g);
+        summary = &localSummary;
+    }
+    std::cout << "=== RAPPORT D'ANALYSE DU GRAPHE ===" << std::endl;
+    std::cout << "Nombre de nœuds: " << num_vertices(g) << std::endl;
+    std::cout << "Nombre d'arêtes: " << num_edges(g) << std::endl;
+    
+    // i. Degrés des nœuds (degré sortant d'un graphe orienté) : répartition à l'écran,
+    // degré de chaque nœud dans centrality.csv (voir runAnalysis)
+    std::cout << "\n== i. " << (summary->directed ? "Degré sortant" : "Degré") << " des nœuds ==" << std::endl;
+    printDegreeHistogram(*summary);
+    
+    auto ids = get(&NodeInfo::id, g);
+    // Afficher le degré du graphe (degré maximum)
+    std::cout << "Degré du graphe: " << summary->maxDegree << std::endl;
+    
+    // Vérifiation la connectivité du graphe
+    std::cout << "\n== ii. Connectivité du graphe ==" << std::endl;
+    std::cout << "Le graphe est " << (summary->connected() ? "connecté" : "non connecté")
+              << (summary->directed ? " (connexité faible : orientation des arcs ignorée)" : "") << std::endl;
+    printComponentStats(summary->components);
+    
+    // Détection de cycles
+    std::cout << "\n== iii. Détection de cycles ==" << std::endl;
+    bool cycle = summary->hasCycle;
+    std::cout << "Le graphe " << (cycle ? "contient":"ne contient pas") << " de cycle" << std::endl;
+    if (cycle) {
+        // cycle témoin, affiché en IDs et tronqué s'il est long
+        auto witness = findCycle(g);
+        const size_t shown = std::min<size_t>(witness.size(), 20);
+        std::cout << "Cycle témoin (" << witness.size() << " nœuds): ";
+        for (size_t i = 0; i < shown; ++i) std::cout << get(ids, witness[i]) << " -> ";
+        if (shown < witness.size()) std::cout << "... -> ";
+        std::cout << get(ids, witness[0]) << std::endl;
+    }
+    std::cout << "Explication de l'algorithme de détection de cycles:" << std::endl;
+    if (summary->directed) {
+        std::cout << "1. Graphe orienté : le nombre d'arcs ne suffit pas, un graphe sans cycle peut avoir plus de V - C arcs" << std::endl;
+        std::cout << "2. Parcours en profondeur (DFS) itératif sur les arcs sortants, chaque nœud est non visité, en cours ou visité" << std::endl;
+        std::cout << "3. Un arc vers un nœud en cours de visite (arc arrière) ferme un cycle orienté ; un arc vers un nœud déjà visité non" << std::endl;
+        std::cout << "4. Le parcours s'arrête à ce premier cycle, reconstruit en remontant les parents" << std::endl;
+    } else {
+        std::cout << "1. Une forêt à C composantes connexes a exactement V - C arêtes : au-delà, il y a forcément un cycle" << std::endl;
+        std::cout << "2. Pour le cycle témoin, parcours en profondeur (DFS) itératif, chaque nœud est non visité, en cours ou visité" << std::endl;
+        std::cout << "3. L'arête par laquelle on arrive sur un nœud est ignorée ; toute autre arête vers un nœud en cours de visite ferme un cycle" << std::endl;
+        std::cout << "4. Le parcours s'arrête à ce premier cycle, reconstruit en remontant les parents" << std::endl;
+    }
+    
+    // iv. Exemple de calcul de chemin le plus court
+    std::cout << "\n== iv. calcul de chemin le plus court ==" << std::endl;
+    std::cout <<"    * node de départ: "<< start <<std::endl;
+    std::cout <<"    * node d'arrivé: "<< end <<std::endl;
+    //int start = 1;  // ID du nœud de départ
+    //int end = 20;   // ID du nœud d'arrivée
+    
+    auto pathResult = shortestPath(g, start, end, mode, index, threads);
+    double pathLength = pathResult.first;
+    const auto& path = pathResult.second;
+    
+    std::cout << "Chemin le plus court de " << start << " à " << end << ": ";
+    if (pathLength < 0) {
+        std::cout << "Pas de chemin trouvé" << std::endl;
+    } else {
+        std::cout << "Longueur = " << std::fixed << std::setprecision(2) << pathLength << std::endl;
+        std::cout << "Chemin: ";
+        for (size_t i = 0; i < path.size(); ++i) {
+            std::cout << path[i];
+            if (i < path.size() - 1) {
+                std::cout << " -> ";
+            }
+        }
+        std::cout << std::endl;
+        
+        // Marquer les arêtes du chemin pour l'illustration
+        markPathEdges(g, path);
+    }
+}
+
+// Liste de paires de nœuds pour le calcul des chemins (paths.csv) : entre les nœuds de
+// rangs 1, 5, 10, 15 et 20 par ID croissant (les IDs 1..20 d'un fichier numéroté à partir
+// de 1, quel que soit l'ordre des sommets) ; un rang au-delà du nombre de nœuds garde sa valeur
+template <class G>
+std::vector<NodePair> analysisNodePairs(const G& g) {
+    const size_t ranks[] = { 1, 5, 10, 15, 20 };
+    auto ids = get(&NodeInfo::id, g);
+    std::vector<NodeId> sorted;
+    for (size_t v = 0; v < num_vertices(g); ++v) sorted.push_back(get(ids, v));
+    const size_t known = std::min<size_t>(sorted.size(), 20);
+    std::partial_sort(sorted.begin(), sorted.begin() + known, sorted.end());
+    std::vector<NodeId> nodes;
+    for (size_t r : ranks) nodes.push_back(r <= known ? sorted[r - 1] : static_cast<NodeId>(r));
+
+    std::vector<NodePair> pairs;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        for (size_t j = i + 1; j < nodes.size(); ++j) pairs.push_back(std::make_pair(nodes[i], nodes[j]));
+    }
+    return pairs;
+}
+
+// Options de la ligne de commande utilisées après le chargement
+struct RunOptions {
+    std::string output_csv = "paths.csv";
+    std::string output_dot = "graph.png";
+    unsigned threads = 1;             // --threads : chargement et composantes connexes
+    unsigned query_threads = 1;
+    PathMode path_mode = PathMode::Dijkstra;
+    std::string coords_file;          // --coords
+    std::string report_file;          // --report : rapport structuré (JSON)
+    std::vector<std::pair<bool, std::string>> deltas;  // --insert / --delete, dans l'ordre (true = ajout)
+    std::string index_file;           // --index / --build-index
+    bool build_index = false;
+    std::uint32_t index_kind = 0;     // 0 = automatique selon la taille
+    size_t landmarks = 16;
+    bool interactive = true;          // questions sur stdin (faux avec --batch, un fichier donné ou stdin hors terminal)
+    NodeId start_node = 1;            // --start / --end : chemin du rapport en mode --batch
+    NodeId end_node = 20;
+    bool has_start_pos = false;       // --start-pos / --end-pos : extrémités données par position
+    bool has_end_pos = false;
+    Point3 start_pos, end_pos;
+    bool serve = false;               // --serve[=SOCKET] : serveur de requêtes au lieu de l'analyse
+    std::string serve_socket;         // vide : stdin / stdout
+    RenderOptions render;             // --render, --render-pos, --render-hops, --render-max-nodes
+    CentralityOptions centrality;     // --centrality[=K], --centrality-seed (threads : --query-threads)
+};
+
+// Index spatial sur les coordonnées des nœuds (--start-pos / --end-pos, requêtes du serveur)
+template <class G>
+SpatialIndex buildSpatialIndex(const G& g) {
+    ScopedPhase phase(Phase::SpatialIndex);
+    return SpatialIndex(g);
+}
+
+// ID du nœud le plus proche d'une position, affiché avec sa distance
+template <class G>
+NodeId nearestNodeId(const G& g, const SpatialIndex& spatial, const Point3& p, const char* label) {
+    SpatialIndex::Neighbor nearest = spatial.nearest(p);
+    if (nearest.vertex >= spatial.size()) return 0;  // graphe vide : ID invalide
+    NodeId id = get(get(&NodeInfo::id, g), nearest.vertex);
+    std::cout << "Position " << label << " (" << p.x << ", " << p.y << ", " << p.z << ") : nœud " << id
+              << " à " << std::fixed << std::setprecision(2) << nearest.distance << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+    return id;
+}
+
+// Construit (--build-index) ou recharge (--index) l'index de distances
+template <class G>
+bool prepareDistanceIndex(const G& g, const RunOptions& opt, DistanceIndex& index) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    if (opt.build_index) {
+        index.build(g, opt.index_kind, opt.landmarks, opt.threads);
+        if (opt.index_kind == DistanceIndex::AllPairs && index.kind() != DistanceIndex::AllPairs) {
+            std::cerr << "Index toutes paires refusé : " << num_vertices(g) << " nœuds (au plus "
+                      << DistanceIndex::kAllPairsMaxVertices << "), repères ALT à la place" << std::endl;
+        }
+        if (!index.save(opt.index_file)) {
+            std::cerr << "Erreur : Impossible d'écrire l'index " << opt.index_file << std::endl;
+            return false;
+        }
+    } else if (!index.load(opt.index_file, g)) {
+        return false;
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::cout << "Index de distances " << (opt.build_index ? "construit" : "chargé") << " : " << opt.index_file
+              << " (" << (index.kind() == DistanceIndex::AllPairs
+                          ? std::string("toutes paires")
+                          : std::to_string(index.landmarkCount()) + " repères ALT")
+              << ") en " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+    return true;
+}
+
+// --centrality : intermédiarité et proximité, avec les nœuds les mieux placés à l'écran
+template <class G>
+CentralityResult reportCentrality(const G& g, const RunOptions& opt) {
+    std::cout << "\n== Centralité ==" << std::endl;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    CentralityResult centrality = computeCentrality(g, opt.centrality, opt.query_threads);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::cout << "Intermédiarité et proximité " << (centrality.exact ? "exactes" : "estimées") << " sur "
+              << centrality.sources << " source(s) en "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+    auto ids = get(&NodeInfo::id, g);
+    const std::ios::fmtflags flags = std::cout.flags();
+    const std::streamsize precision = std::cout.precision(6);
+    std::cout.unsetf(std::ios::floatfield);
+    auto printTop = [&](const char* label, const std::vector<double>& values) {
+        std::cout << label;
+        for (size_t v : topVertices(values, 10)) std::cout << " " << get(ids, v) << " (" << values[v] << ")";
+        std::cout << std::endl;
+    };
+    printTop("Nœuds les plus intermédiaires:", centrality.betweenness);
+    printTop("Nœuds les plus proches des autres:", centrality.closeness);
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+    return centrality;
+}
+
+// Suite de l'analyse une fois le graphe chargé (adjacency_list ou CSR figé)
+template <class G>
+void runAnalysis(G& g, const RunOptions& opt) {
+    // --coords : nouvelles positions des nœuds, les poids sont recalculés sans recharger edges.csv
+    if (!opt.coords_file.empty()) reloadCoordinates(g, loadNodes(opt.coords_file));
+    
+    DistanceIndex index;
+    const DistanceIndex* indexPtr = nullptr;
+    if (!opt.index_file.empty() && prepareDistanceIndex(g, opt, index)) indexPtr = &index;
+    
+    // Analyse fusionnée en un parcours : rapport, components.csv et --report
+    // (ou réponses du serveur de requêtes)
+    if (opt.serve) {
+        GraphSummary summary = summarizeGraph(g, opt.threads);
+        SpatialIndex spatial = buildSpatialIndex(g);
+        QueryServer<G> server(g, summary, opt.query_threads, opt.path_mode, indexPtr, &spatial);
+        if (opt.serve_socket.empty()) {
+            std::cerr << "Serveur prêt : une requête par ligne sur stdin (path S T, degree N, connected [S T], cycle, stats, quit)" << std::endl;
+            server.serve(0, 1);
+        } else {
+            server.serveUnixSocket(opt.serve_socket);
+        }
+        return;
+    }
+    
+    NodeId node1 = opt.start_node, node2 = opt.end_node; // Variables to store the user's input
+
+    // --start-pos / --end-pos : nœuds les plus proches des positions données
+    if (opt.has_start_pos || opt.has_end_pos) {
+        SpatialIndex spatial = buildSpatialIndex(g);
+        if (opt.has_start_pos) node1 = nearestNodeId(g, spatial, opt.start_pos, "de départ");
+        if (opt.has_end_pos) node2 = nearestNodeId(g, spatial, opt.end_pos, "d'arrivée");
+    }
+
+    if (opt.interactive) {
+        std::cout << "Selection de 2 nodes pour un calcul de chemin" << std::endl;
+        if (!opt.has_start_pos) {
+            // Prompt the user for the first number
+            std::cout << "Entrer la node de départ: ";
+            std::cin >> node1;
+        }
+        if (!opt.has_end_pos) {
+            // Prompt the user for the second number
+            std::cout << "Entrer la node d'arrivé': ";
+            std::cin >> node2;
+        }
+    }
+
+    GraphSummary summary = summarizeGraph(g, opt.threads);
+    
+    // Générer le rapport d'analyse
+    generateGraphReport(g, node1, node2, opt.path_mode, indexPtr, &summary, opt.query_threads);
+    if (!opt.report_file.empty()) {
+        if (writeSummaryJson(summary, opt.report_file)) {
+            std::cout << "Rapport structuré généré : " << opt.report_file << std::endl;
+        } else {
+            std::cerr << "Erreur : Impossible de créer le rapport " << opt.report_file << std::endl;
+        }
+    }
+    
+    CentralityResult centrality;
+    if (opt.centrality.enabled) centrality = reportCentrality(g, opt);
+    
+    // v. Générer une illustration du graphe
+    generateGraphImage(g, opt.output_dot, opt.render);
+    
+    // vi. Écrire les chemins dans un fichier CSV
+    std::vector<NodePair> nodePairs = analysisNodePairs(g);
+    writePathsToCSV(g, nodePairs, opt.output_csv, opt.query_threads, opt.path_mode, indexPtr);
+    writeComponentsToCSV(g, summary.components, componentsFileFor(opt.output_csv));
+    writeCentralityToCSV(g, summary.degree, opt.centrality.enabled ? &centrality : nullptr,
+                         centralityFileFor(opt.output_csv));
+}
+
+extern template void runAnalysis<Graph>(Graph&, const RunOptions&);
+extern template void runAnalysis<BasicCsrGraph<UndirectedConfig>>(BasicCsrGraph<UndirectedConfig>&, const RunOptions&);
+extern template void runAnalysis<BasicCsrGraph<UndirectedNarrowConfig>>(BasicCsrGraph<UndirectedNarrowConfig>&, const RunOptions&);
+extern template void runAnalysis<BasicCsrGraph<UndirectedFloatConfig>>(BasicCsrGraph<UndirectedFloatConfig>&, const RunOptions&);
+extern template void runAnalysis<BasicCsrGraph<UndirectedCompactConfig>>(BasicCsrGraph<UndirectedCompactConfig>&, const RunOptions&);
+extern template void runAnalysis<DirectedGraph>(DirectedGraph&, const RunOptions&);
+extern template void runAnalysis<BasicCsrGraph<DirectedConfig>>(BasicCsrGraph<DirectedConfig>&, const RunOptions&);
+extern template void runAnalysis<BasicCsrGraph<DirectedNarrowConfig>>(BasicCsrGraph<DirectedNarrowConfig>&, const RunOptions&);
+extern template void runAnalysis<BasicCsrGraph<DirectedFloatConfig>>(BasicCsrGraph<DirectedFloatConfig>&, const RunOptions&);
+extern template void runAnalysis<BasicCsrGraph<DirectedCompactConfig>>(BasicCsrGraph<DirectedCompactConfig>&, const RunOptions&);
+
+#endif
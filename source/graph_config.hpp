@@ -0,0 +1,116 @@
+#ifndef GRAPH_CONFIG_HPP
+#define GRAPH_CONFIG_HPP
+
+// Configurations du graphe figé (CSR, voir csr_graph.hpp), fixées à la compilation :
+// - orientation : non orienté (chaque arête dans les deux listes d'adjacence) ou orienté
+//   (arcs Source -> Target de edges.csv, une seule case par arc)
+// - type des poids : double, ou float pour diviser par deux le tableau des poids
+// - largeur des indices stockés (offsets, voisins, extrémités) : 64 ou 32 bits
+// Les descripteurs de sommet restent des std::size_t : seuls les tableaux rétrécissent.
+// Les instanciations utilisées sont compilées une fois chacune (analysis_*.cpp) et
+// choisies à l'exécution (GraphLayout : options, en-tête du snapshot, taille du graphe).
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <boost/graph/graph_traits.hpp>
+
+template <class Directed, class Weight, class Index>
+struct GraphConfig {
+    typedef Directed directed_category;  // boost::undirected_tag ou boost::directed_tag
+    typedef Weight weight_type;
+    typedef Index index_type;
+    static constexpr bool directed = !std::is_same<Directed, boost::undirected_tag>::value;
+};
+
+typedef GraphConfig<boost::undirected_tag, double, std::size_t> UndirectedConfig;  // historique
+typedef GraphConfig<boost::undirected_tag, double, std::uint32_t> UndirectedNarrowConfig;
+typedef GraphConfig<boost::undirected_tag, float, std::size_t> UndirectedFloatConfig;
+typedef GraphConfig<boost::undirected_tag, float, std::uint32_t> UndirectedCompactConfig;
+typedef GraphConfig<boost::directed_tag, double, std::size_t> DirectedConfig;
+typedef GraphConfig<boost::directed_tag, double, std::uint32_t> DirectedNarrowConfig;
+typedef GraphConfig<boost::directed_tag, float, std::size_t> DirectedFloatConfig;
+typedef GraphConfig<boost::directed_tag, float, std::uint32_t> DirectedCompactConfig;
+
+// Largeur des indices : auto = 32 bits dès que le graphe le permet
+enum class IndexWidth { Auto, Narrow, Wide };
+
+// Choix de la configuration à l'exécution
+struct GraphLayout {
+    bool directed = false;      // --directed
+    bool floatWeights = false;  // --weights=float
+    IndexWidth index = IndexWidth::Auto;  // --index-width=auto|32|64
+
+    // Indices 32 bits possibles : offsets jusqu'à 2m, et sommets < 2^31 pour les gathers
+    // signés du calcul des poids (weights_simd.hpp)
+    static bool fitsNarrow(std::size_t n, std::size_t m) {
+        return n < (std::size_t(1) << 31) && 2 * m <= std::numeric_limits<std::uint32_t>::max();
+    }
+    // --index-width=32 sur un graphe trop grand retombe sur 64 bits
+    bool narrowFor(std::size_t n, std::size_t m) const {
+        return index != IndexWidth::Wide && fitsNarrow(n, m);
+    }
+    // Drapeaux de l'en-tête du snapshot (0 : non orienté, double, 64 bits)
+    static constexpr std::uint64_t kDirected = 1;
+    static constexpr std::uint64_t kFloatWeights = 2;
+    static constexpr std::uint64_t kNarrowIndex = 4;
+
+    // Configuration retenue pour un graphe de n sommets et m arêtes
+    std::uint64_t flagsFor(std::size_t n, std::size_t m) const {
+        return (directed ? kDirected : 0) | (floatWeights ? kFloatWeights : 0) |
+               (narrowFor(n, m) ? kNarrowIndex : 0);
+    }
+};
+
+inline bool parseIndexWidth(const std::string& name, IndexWidth& width) {
+    if (name == "auto") width = IndexWidth::Auto;
+    else if (name == "32") width = IndexWidth::Narrow;
+    else if (name == "64") width = IndexWidth::Wide;
+    else return false;
+    return true;
+}
+
+inline bool parseWeightType(const std::string& name, bool& floatWeights) {
+    if (name == "double") floatWeights = false;
+    else if (name == "float") floatWeights = true;
+    else return false;
+    return true;
+}
+
+template <class Config>
+std::uint64_t configFlags() {
+    return (Config::directed ? GraphLayout::kDirected : 0) |
+           (sizeof(typename Config::weight_type) == 4 ? GraphLayout::kFloatWeights : 0) |
+           (sizeof(typename Config::index_type) == 4 ? GraphLayout::kNarrowIndex : 0);
+}
+
+template <class Config>
+std::string configName() {
+    return std::string(Config::directed ? "orienté" : "non orienté") + ", poids " +
+           (sizeof(typename Config::weight_type) == 4 ? "float" : "double") + ", indices " +
+           (sizeof(typename Config::index_type) == 4 ? "32" : "64") + " bits";
+}
+
+// Appelle body(Config()) avec la configuration d'orientation Directed (boost::undirected_tag
+// ou boost::directed_tag) qui correspond aux drapeaux
+template <class Directed, class Body>
+void withGraphConfigOf(std::uint64_t flags, Body body) {
+    if (flags & GraphLayout::kFloatWeights) {
+        if (flags & GraphLayout::kNarrowIndex) body(GraphConfig<Directed, float, std::uint32_t>());
+        else body(GraphConfig<Directed, float, std::size_t>());
+    } else {
+        if (flags & GraphLayout::kNarrowIndex) body(GraphConfig<Directed, double, std::uint32_t>());
+        else body(GraphConfig<Directed, double, std::size_t>());
+    }
+}
+
+// Même chose, orientation comprise (snapshot)
+template <class Body>
+void withGraphConfig(std::uint64_t flags, Body body) {
+    if (flags & GraphLayout::kDirected) withGraphConfigOf<boost::directed_tag>(flags, body);
+    else withGraphConfigOf<boost::undirected_tag>(flags, body);
+}
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef GRAPH_GENERATORS_HPP
+#define GRAPH_GENERATORS_HPP
+
+// Graphes géométriques 3D synthétiques pour les benchmarks, écrits au format de
+// nodes.csv / edges.csv ; même graine => mêmes fichiers
+// - rgg : graphe géométrique aléatoire, points uniformes dans un cube (densité 1 point
+//   par cube de 10 de côté), arête entre deux points à distance < r, r choisi pour un
+//   degré moyen de 8 (moins au bord) ; voisins cherchés dans une grille de cellules de côté r
+// - grid : maillage cubique s x s x s, 6 voisins, positions légèrement perturbées
+// - scalefree : attachement préférentiel (Barabási-Albert), 4 arêtes par nouveau nœud,
+//   positions uniformes dans le cube
+// Le nombre d'arêtes demandé fixe la taille ; le nombre obtenu en est proche, pas exact.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "graph_types.hpp"
+#include "soa_properties.hpp"
+
+enum class GeneratorKind { Geometric, Grid, ScaleFree };
+
+inline const char* generatorName(GeneratorKind kind) {
+    switch (kind) {
+    case GeneratorKind::Grid: return "grid";
+    case GeneratorKind::ScaleFree: return "scalefree";
+    default: return "rgg";
+    }
+}
+
+inline bool parseGeneratorKind(const std::string& name, GeneratorKind& kind) {
+    if (name == "rgg") kind = GeneratorKind::Geometric;
+    else if (name == "grid") kind = GeneratorKind::Grid;
+    else if (name == "scalefree") kind = GeneratorKind::ScaleFree;
+    else return false;
+    return true;
+}
+
+// Nœuds (ID = indice + 1) et arêtes en indices 0-based, sans poids
+struct SyntheticGraph {
+    std::vector<NodeInfo> nodes;
+    EdgeBatch edges;
+};
+
+namespace generator_detail {
+
+const double kSpacing = 10.0;  // distance moyenne entre points voisins
+
+inline void uniformPoints(SyntheticGraph& out, std::size_t n, std::mt19937_64& rng) {
+    double side = kSpacing * std::cbrt(static_cast<double>(n));
+    std::uniform_real_distribution<double> coord(0.0, side);
+    out.nodes.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        out.nodes[i].id = static_cast<NodeId>(i + 1);
+        out.nodes[i].x = coord(rng);
+        out.nodes[i].y = coord(rng);
+        out.nodes[i].z = coord(rng);
+    }
+}
+
+inline void geometric(SyntheticGraph& out, std::size_t m, std::mt19937_64& rng) {
+    const double degree = 8.0;
+    std::size_t n = std::max<std::size_t>(2, static_cast<std::size_t>(2.0 * m / degree));
+    uniformPoints(out, n, rng);
+    // n * (4/3 pi r^3) / volume = degré moyen
+    const double r = kSpacing * std::cbrt(3.0 * degree / (4.0 * M_PI));
+    const double side = kSpacing * std::cbrt(static_cast<double>(n));
+    const std::size_t cells = std::max<std::size_t>(1, static_cast<std::size_t>(side / r));
+    const double cellSize = side / cells;
+    auto cellOf = [&](double c) {
+        return std::min(cells - 1, static_cast<std::size_t>(c / cellSize));
+    };
+    auto cellIndex = [&](std::size_t cx, std::size_t cy, std::size_t cz) { return (cz * cells + cy) * cells + cx; };
+
+    // tri par comptage des points dans leur cellule
+    std::vector<std::size_t> start(cells * cells * cells + 1, 0), order(n);
+    std::vector<std::size_t> cellOfPoint(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const NodeInfo& p = out.nodes[i];
+        cellOfPoint[i] = cellIndex(cellOf(p.x), cellOf(p.y), cellOf(p.z));
+        ++start[cellOfPoint[i] + 1];
+    }
+    for (std::size_t c = 1; c < start.size(); ++c) start[c] += start[c - 1];
+    std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+    for (std::size_t i = 0; i < n; ++i) order[fill[cellOfPoint[i]]++] = i;
+
+    out.edges.reserve(static_cast<std::size_t>(m * 1.05));
+    for (std::size_t i = 0; i < n; ++i) {
+        const NodeInfo& p = out.nodes[i];
+        std::size_t cx = cellOf(p.x), cy = cellOf(p.y), cz = cellOf(p.z);
+        for (std::size_t z = cz ? cz - 1 : 0; z <= std::min(cells - 1, cz + 1); ++z) {
+            for (std::size_t y = cy ? cy - 1 : 0; y <= std::min(cells - 1, cy + 1); ++y) {
+                for (std::size_t x = cx ? cx - 1 : 0; x <= std::min(cells - 1, cx + 1); ++x) {
+                    std::size_t c = cellIndex(x, y, z);
+                    for (std::size_t k = start[c]; k < start[c + 1]; ++k) {
+                        std::size_t j = order[k];
+                        if (j <= i) continue;  // chaque paire une seule fois
+                        const NodeInfo& q = out.nodes[j];
+                        double dx = p.x - q.x, dy = p.y - q.y, dz = p.z - q.z;
+                        if (dx*dx + dy*dy + dz*dz < r * r) out.edges.push(static_cast<int>(i), static_cast<int>(j));
+                    }
+                }
+            }
+        }
+    }
+}
+
+inline void grid(SyntheticGraph& out, std::size_t m, std::mt19937_64& rng) {
+    // s^3 nœuds, 3 s^2 (s - 1) arêtes
+    std::size_t s = std::max<std::size_t>(2, static_cast<std::size_t>(std::llround(std::cbrt(m / 3.0))));
+    std::size_t n = s * s * s;
+    std::uniform_real_distribution<double> jitter(-0.2 * kSpacing, 0.2 * kSpacing);
+    out.nodes.resize(n);
+    auto index = [s](std::size_t x, std::size_t y, std::size_t z) { return (z * s + y) * s + x; };
+    out.edges.reserve(3 * s * s * (s - 1));
+    for (std::size_t z = 0; z < s; ++z) {
+        for (std::size_t y = 0; y < s; ++y) {
+            for (std::size_t x = 0; x < s; ++x) {
+                std::size_t v = index(x, y, z);
+                NodeInfo& node = out.nodes[v];
+                node.id = static_cast<NodeId>(v + 1);
+                node.x = x * kSpacing + jitter(rng);
+                node.y = y * kSpacing + jitter(rng);
+                node.z = z * kSpacing + jitter(rng);
+                if (x + 1 < s) out.edges.push(static_cast<int>(v), static_cast<int>(index(x + 1, y, z)));
+                if (y + 1 < s) out.edges.push(static_cast<int>(v), static_cast<int>(index(x, y + 1, z)));
+                if (z + 1 < s) out.edges.push(static_cast<int>(v), static_cast<int>(index(x, y, z + 1)));
+            }
+        }
+    }
+}
+
+inline void scaleFree(SyntheticGraph& out, std::size_t m, std::mt19937_64& rng) {
+    const std::size_t attach = 4, seed = attach + 1;
+    std::size_t n = std::max(seed + 1, m / attach);
+    uniformPoints(out, n, rng);
+    out.edges.reserve(m + attach * seed);
+    // extrémités de toutes les arêtes : tirer dedans = tirer un nœud au prorata de son degré
+    std::vector<int> endpoints;
+    endpoints.reserve(2 * (m + attach * seed));
+    for (std::size_t u = 0; u < seed; ++u) {
+        for (std::size_t v = u + 1; v < seed; ++v) {
+            out.edges.push(static_cast<int>(u), static_cast<int>(v));
+            endpoints.push_back(static_cast<int>(u));
+            endpoints.push_back(static_cast<int>(v));
+        }
+    }
+    int chosen[attach];
+    for (std::size_t u = seed; u < n; ++u) {
+        std::uniform_int_distribution<std::size_t> pick(0, endpoints.size() - 1);
+        std::size_t count = 0;
+        while (count < attach) {
+            int v = endpoints[pick(rng)];
+            if (std::find(chosen, chosen + count, v) == chosen + count) chosen[count++] = v;
+        }
+        for (int v : chosen) {
+            out.edges.push(static_cast<int>(u), v);
+            endpoints.push_back(static_cast<int>(u));
+            endpoints.push_back(v);
+        }
+    }
+}
+
+// Sortie par gros blocs (un fwrite par Mo)
+class BlockWriter {
+public:
+    explicit BlockWriter(const std::string& filename) : _file(std::fopen(filename.c_str(), "wb")) {}
+    ~BlockWriter() { close(); }
+
+    bool is_open() const { return _file != nullptr; }
+    void append(const char* text, std::size_t size) {
+        _buffer.append(text, size);
+        if (_buffer.size() >= (1u << 20)) flush();
+    }
+    void append(const std::string& text) { append(text.data(), text.size()); }
+    bool close() {
+        if (!_file) return _ok;
+        flush();
+        _ok = std::fclose(_file) == 0 && _ok;
+        _file = nullptr;
+        return _ok;
+    }
+
+private:
+    void flush() {
+        if (!_buffer.empty() && std::fwrite(_buffer.data(), 1, _buffer.size(), _file) != _buffer.size()) _ok = false;
+        _buffer.clear();
+    }
+
+    std::FILE* _file;
+    std::string _buffer;
+    bool _ok = true;
+};
+
+} // namespace generator_detail
+
+// Graphe d'environ targetEdges arêtes
+inline SyntheticGraph generateGraph(GeneratorKind kind, std::size_t targetEdges, std::uint64_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    SyntheticGraph out;
+    switch (kind) {
+    case GeneratorKind::Geometric: generator_detail::geometric(out, targetEdges, rng); break;
+    case GeneratorKind::Grid: generator_detail::grid(out, targetEdges, rng); break;
+    case GeneratorKind::ScaleFree: generator_detail::scaleFree(out, targetEdges, rng); break;
+    }
+    return out;
+}
+
+// Écrit nodes.csv (Nodeid;x;y;z) et edges.csv (Source Node ID;Target Node ID), IDs à partir de 1
+inline bool writeSyntheticCsv(const SyntheticGraph& graph, const std::string& nodesFile, const std::string& edgesFile) {
+    generator_detail::BlockWriter nodes(nodesFile), edges(edgesFile);
+    if (!nodes.is_open() || !edges.is_open()) return false;
+    char line[128];
+    nodes.append("Nodeid;x;y;z\n");
+    for (const NodeInfo& node : graph.nodes) {
+        int size = std::snprintf(line, sizeof line, "%lld;%.3f;%.3f;%.3f\n", static_cast<long long>(node.id), node.x, node.y, node.z);
+        nodes.append(line, static_cast<std::size_t>(size));
+    }
+    edges.append("Source Node ID;Target Node ID\n");
+    for (std::size_t i = 0; i < graph.edges.size(); ++i) {
+        int size = std::snprintf(line, sizeof line, "%d;%d\n", graph.edges.source[i] + 1, graph.edges.target[i] + 1);
+        edges.append(line, static_cast<std::size_t>(size));
+    }
+    bool nodesOk = nodes.close();
+    bool edgesOk = edges.close();
+    return nodesOk && edgesOk;
+}
+
+#endif
@@ -0,0 +1,449 @@
+#ifndef GRAPH_IO_HPP
+#define GRAPH_IO_HPP
+
+// Lecture et écriture des fichiers du graphe, partagées par graph_analysis et bench_graph
+// - chargement : nodes.csv, edges.csv (séquentiel ou parallèle), fichiers de mise à jour,
+//   nouvelles coordonnées avec recalcul des poids
+// - sorties : paths.csv, components.csv, graphe au format DOT (écrits par blocs,
+//   voir buffered_writer.hpp)
+// le débit de chaque chargement est affiché sur std::cout
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "csv_mmap.hpp"
+#include "weights_simd.hpp"
+#include "graph_types.hpp"
+#include "soa_properties.hpp"
+#include "connected_components.hpp"
+#include "path_engine.hpp"
+#include "metrics.hpp"
+#include "buffered_writer.hpp"
+
+// Affiche le débit de chargement d'un fichier CSV
+inline void reportLoadThroughput(const std::string& filename, std::size_t bytes,
+                                 std::chrono::high_resolution_clock::time_point t0) {
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    double megabytes = bytes / (1024.0 * 1024.0);
+    std::cout << "Chargement " << filename << " : " << std::fixed << std::setprecision(2)
+              << megabytes << " Mo en " << seconds * 1000.0 << " ms ("
+              << (seconds > 0 ? megabytes / seconds : 0.0) << " Mo/s)" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+// Fonctions pour charger les données
+// le fichier est projeté en mémoire (voir csv_mmap.hpp), aucune allocation par ligne
+inline std::vector<NodeInfo> loadNodes(const std::string& filename) {
+    std::vector<NodeInfo> nodes; // on fabrique un vecteur remplie de nodeInfo pour stocker la data
+    ScopedPhase phase(Phase::ParseNodes);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    MappedFile file(filename);
+    
+    // verification classique si le fichier est bien là
+    if (!file.is_open()) {
+        std::cerr << "Erreur lors de l'ouverture du fichier " << filename << std::endl;
+        return nodes;
+    }
+    
+    const char* p = file.begin();
+    const char* end = file.end();
+    CsvField line, field;
+    
+    // Ignorer le BOM puis la première ligne (en-têtes)
+    skipUtf8Bom(p, end);
+    nextLine(p, end, line);
+    // Parcour le reste du fichier
+    while (nextLine(p, end, line)) {
+        const char* f = line.begin;
+        NodeInfo node; // creation new node
+        node.x = node.y = node.z = 0.0;
+        if (!nextField(f, line.end, field) || !parseField(field, node.id)) continue; // 1er colonne = ID
+        if (nextField(f, line.end, field)) parseField(field, node.x);
+        if (nextField(f, line.end, field)) parseField(field, node.y);
+        if (nextField(f, line.end, field)) parseField(field, node.z);
+        
+        nodes.push_back(node);
+    }
+    Metrics::add(Counter::RowsParsed, nodes.size());
+    
+    reportLoadThroughput(filename, file.size(), t0);
+    return nodes;
+}
+
+// Lit une ligne "Source;Target" et la convertit en indices du graphe
+// retourne false si la ligne est invalide ou si un ID est inconnu
+// (partagé par le chargement séquentiel et le chargement parallèle)
+inline bool parseEdgeRow(const NodeIdMap& ids, std::size_t n, const CsvField& line, int& source, int& target) {
+    const char* f = line.begin;
+    CsvField field;
+    NodeId sourceId, targetId;
+    if (!nextField(f, line.end, field) || !parseField(field, sourceId)) return false;
+    if (!nextField(f, line.end, field) || !parseField(field, targetId)) return false;
+    // les IDs du CSV deviennent des indices 0..n-1 (voir node_ids.hpp)
+    std::size_t s = ids.vertex(sourceId, n);
+    std::size_t t = ids.vertex(targetId, n);
+    if (s >= n || t >= n) return false;
+    source = static_cast<int>(s);
+    target = static_cast<int>(t);
+    return true;
+}
+
+// Lit toutes les lignes de [p, end) dans un EdgeBatch puis calcule les poids
+// en une passe sur les coordonnées SoA (voir computeEdgeWeights)
+inline void parseEdgeRange(const NodeCoords& coords, const NodeIdMap& ids, const char* p, const char* end,
+                           EdgeBatch& batch) {
+    const std::size_t n = coords.size();
+    // ~10 octets par ligne "a;b\r\n", évite la plupart des réallocations
+    batch.reserve((end - p) / 8);
+    CsvField line;
+    int source, target;
+    std::uint64_t rows = 0, rejected = 0;
+    while (nextLine(p, end, line)) {
+        ++rows;
+        if (parseEdgeRow(ids, n, line, source, target)) batch.push(source, target);
+        else ++rejected;
+    }
+    Metrics::add(Counter::RowsParsed, rows);
+    Metrics::add(Counter::EdgesRejected, rejected);
+    computeEdgeWeights(coords, batch);
+}
+
+// Première passe avant insertion : degré apporté par chaque tranche, puis réservation
+// exacte des listes d'arêtes sortantes => pas de réallocation ni de capacité doublée
+// pendant add_edge (une boucle u-u compte deux fois pour u, comme dans add_edge ;
+// en orienté seule la source reçoit l'arc)
+template <class D>
+void reserveOutEdges(BasicGraph<D>& g, const EdgeBatch* first, const EdgeBatch* last) {
+    const bool directed = boost::is_directed_graph<BasicGraph<D>>::value;
+    std::vector<std::uint32_t> degree(boost::num_vertices(g), 0);
+    for (const EdgeBatch* batch = first; batch != last; ++batch) {
+        for (size_t i = 0; i < batch->size(); ++i) {
+            ++degree[batch->source[i]];
+            if (!directed) ++degree[batch->target[i]];
+        }
+    }
+    for (size_t v = 0; v < degree.size(); ++v) {
+        if (degree[v]) g.out_edge_list(v).reserve(g.out_edge_list(v).size() + degree[v]);
+    }
+}
+
+// Ajouter les arêtes au graphe avec leur poids (listes déjà réservées par reserveOutEdges)
+template <class D>
+void appendEdgeBatch(BasicGraph<D>& g, const EdgeBatch& batch) {
+    Metrics::add(Counter::EdgesInserted, batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EdgeInfo info;
+        info.weight = batch.weight[i];
+        info.inPath = false;
+        boost::add_edge(batch.source[i], batch.target[i], info, g);
+    }
+}
+
+template <class D>
+void insertEdgeBatch(BasicGraph<D>& g, const EdgeBatch& batch) {
+    reserveOutEdges(g, &batch, &batch + 1);
+    appendEdgeBatch(g, batch);
+}
+
+// Version parallèle : le fichier est découpé en tranches sur des fins de ligne,
+// chaque thread lit sa tranche et calcule les poids dans son propre buffer
+// (seules les coordonnées sont lues pendant cette phase), puis les buffers sont insérés
+// dans l'ordre des tranches => même graphe, même ordre d'arêtes qu'en séquentiel
+template <class D>
+void loadEdgesParallel(BasicGraph<D>& g, const NodeCoords& coords, const char* p, const char* end, unsigned threads) {
+    std::vector<CsvField> chunks = splitOnLines(p, end, threads);
+    std::vector<EdgeBatch> buffers(chunks.size());
+    const NodeIdMap& ids = nodeIdMap(g);
+    
+    {
+        ScopedPhase phase(Phase::ParseEdges);
+        std::vector<std::thread> workers;
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            workers.emplace_back([&coords, &ids, &chunks, &buffers, c]() {
+                parseEdgeRange(coords, ids, chunks[c].begin, chunks[c].end, buffers[c]);
+            });
+        }
+        for (auto& w : workers) w.join();
+    }
+    
+    // Fusion dans l'ordre du fichier, après une réservation unique pour toutes les tranches
+    ScopedPhase phase(Phase::BuildGraph);
+    reserveOutEdges(g, buffers.data(), buffers.data() + buffers.size());
+    for (const auto& buffer : buffers) appendEdgeBatch(g, buffer);
+}
+
+// voir loadNodes car c'est pareil
+// ! le graph est dejà fait, on ajoute juste arretes
+// d'ou le void
+// threads > 1 active le chargement parallèle (0 = nombre de coeurs)
+// DirectedGraph : chaque ligne Source;Target est un arc Source -> Target
+template <class D>
+void loadEdges(BasicGraph<D>& g, const std::string& filename, unsigned threads = 1) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    MappedFile file(filename);
+    
+    if (!file.is_open()) {
+        std::cerr << "Erreur durant l'ouverture du fichier " << filename << std::endl;
+        return;
+    }
+    
+    const char* p = file.begin();
+    const char* end = file.end();
+    CsvField line;
+    
+    skipUtf8Bom(p, end);
+    nextLine(p, end, line);
+    
+    // Copie SoA des coordonnées : le calcul des poids ne lit que x[], y[], z[]
+    NodeCoords coords = nodeCoordsOf(g);
+    
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads > 1) {
+        loadEdgesParallel(g, coords, p, end, threads);
+    } else {
+        EdgeBatch batch;
+        {
+            ScopedPhase phase(Phase::ParseEdges);
+            parseEdgeRange(coords, nodeIdMap(g), p, end, batch);
+        }
+        ScopedPhase phase(Phase::BuildGraph);
+        insertEdgeBatch(g, batch);
+    }
+    
+    reportLoadThroughput(filename, file.size(), t0);
+}
+
+// Lit un fichier de mise à jour au format de edges.csv (Source;Target) ;
+// les poids sont calculés comme au chargement
+inline bool loadEdgeDelta(const NodeCoords& coords, const NodeIdMap& ids, const std::string& filename,
+                          EdgeBatch& batch) {
+    MappedFile file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Erreur durant l'ouverture du fichier " << filename << std::endl;
+        return false;
+    }
+    const char* p = file.begin();
+    const char* end = file.end();
+    CsvField line;
+    skipUtf8Bom(p, end);
+    nextLine(p, end, line);
+    parseEdgeRange(coords, ids, p, end, batch);
+    return true;
+}
+
+// Recalcule les poids d'un graphe déjà construit (adjacency_list) :
+// les extrémités sont rassemblées en SoA, le noyau SIMD calcule tout le lot
+template <class D>
+void recomputeWeights(BasicGraph<D>& g, WeightKernel kernel = bestWeightKernel()) {
+    NodeCoords coords = nodeCoordsOf(g);
+    EdgeBatch batch;
+    batch.reserve(boost::num_edges(g));
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // edge_iterator orienté de Boost, voir graph_types.hpp
+    typename boost::graph_traits<BasicGraph<D>>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei) {
+        batch.push(static_cast<int>(boost::source(*ei, g)), static_cast<int>(boost::target(*ei, g)));
+    }
+#pragma GCC diagnostic pop
+    batch.weight.resize(batch.size());
+    computeWeightsBatch(coords.x.data(), coords.y.data(), coords.z.data(),
+                        batch.source.data(), batch.target.data(), batch.weight.data(), batch.size(), kernel);
+    size_t i = 0;
+    for (boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei, ++i) {
+        g[*ei].weight = batch.weight[i];
+    }
+}
+
+// Nouvelles coordonnées pour un maillage qui bouge (même topologie) :
+// on remplace x, y, z des nœuds (retrouvés par leur ID) puis on recalcule tous les poids d'un coup
+template <class G>
+void reloadCoordinates(G& g, const std::vector<NodeInfo>& nodes) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto xs = get(&NodeInfo::x, g);
+    auto ys = get(&NodeInfo::y, g);
+    auto zs = get(&NodeInfo::z, g);
+    const size_t n = num_vertices(g);
+    for (const NodeInfo& node : nodes) {
+        size_t v = nodeIndex(g, node.id);
+        if (v >= n) continue;  // ID absent du graphe
+        put(xs, v, node.x);
+        put(ys, v, node.y);
+        put(zs, v, node.z);
+    }
+    recomputeWeights(g);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::cout << "Recalcul des poids : " << num_edges(g) << " arêtes en "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms (noyau "
+              << weightKernelName(bestWeightKernel()) << ")" << std::endl;
+}
+
+// Graphe sans arêtes sur ces nœuds (dans l'ordre des lignes) et correspondance ID -> indice
+template <class D>
+void assignNodes(BasicGraph<D>& g, const std::vector<NodeInfo>& nodes) {
+    g = BasicGraph<D>(nodes.size());
+    for (size_t v = 0; v < nodes.size(); ++v) g[v] = nodes[v];
+    rebuildNodeIdMap(g);
+}
+
+// Charge nodes.csv puis edges.csv dans g
+template <class D>
+bool loadCsvGraph(BasicGraph<D>& g, const std::string& nodes_file, const std::string& edges_file, unsigned threads) {
+    // Charger les nœuds
+    std::vector<NodeInfo> nodes = loadNodes(nodes_file);
+    
+    if (nodes.empty()) {
+        std::cerr << "Erreur : Aucun nœud chargé." << std::endl;
+        return false;
+    }
+    
+    // Créer le graphe avec le bon nombre de nœuds et la correspondance ID -> indice
+    assignNodes(g, nodes);
+    const NodeIdMap& ids = nodeIdMap(g);
+    if (ids.kind() != NodeIdMap::Offset) {
+        std::cout << "IDs des nœuds non consécutifs : correspondance par " << ids.kindName() << std::endl;
+    }
+    if (ids.duplicates() > 0) {
+        std::cerr << "Attention : " << ids.duplicates() << " ID(s) de nœud en double, la première ligne est retenue"
+                  << std::endl;
+    }
+    
+    // Charger les arêtes
+    loadEdges(g, edges_file, threads);
+    return true;
+}
+
+// Composante de chaque nœud : NodeID;ComponentID;ComponentSize
+template <class G>
+void writeComponentsToCSV(const G& g, const ComponentLabels& labels, const std::string& filename) {
+    ScopedPhase phase(Phase::WriteCsv);
+    BufferedWriter csvFile(filename);
+    if (!csvFile.is_open()) {
+        std::cerr << "Erreur : Impossible de créer le fichier CSV." << std::endl;
+        return;
+    }
+    csvFile.write("NodeID;ComponentID;ComponentSize\n");
+    auto ids = get(&NodeInfo::id, g);
+    for (size_t v = 0; v < labels.component.size(); ++v) {
+        size_t c = labels.component[v];
+        csvFile.writeInt(get(ids, v));
+        csvFile.put(';');
+        csvFile.writeInt(c);
+        csvFile.put(';');
+        csvFile.writeInt(labels.sizes[c]);
+        csvFile.put('\n');
+    }
+    if (!csvFile.close()) std::cerr << "Erreur : Écriture incomplète de " << filename << std::endl;
+    Metrics::add(Counter::BytesWritten, csvFile.bytesWritten());
+    std::cout << "Fichier CSV généré : " << filename << std::endl;
+}
+
+// components.csv est rangé dans le même dossier que paths.csv
+inline std::string componentsFileFor(const std::string& pathsFile) {
+    size_t slash = pathsFile.find_last_of('/');
+    return (slash == std::string::npos ? std::string() : pathsFile.substr(0, slash + 1)) + "components.csv";
+}
+
+// Écrit des résultats de chemins déjà calculés (un par paire, dans le même ordre)
+// texte formaté par blocs (buffered_writer.hpp), identique à l'ancienne sortie iostream
+inline void writePathResultsToCSV(const std::vector<NodePair>& nodePairs, const std::vector<PathResult>& results,
+                                  const std::string& filename) {
+    ScopedPhase phase(Phase::WriteCsv);
+    BufferedWriter csvFile(filename);
+    if (!csvFile.is_open()) {
+        std::cerr << "Erreur : Impossible de créer le fichier CSV." << std::endl;
+        return;
+    }
+    
+    // Écrire l'en-tête du CSV
+    csvFile.write("SourceNodeID;TargetNodeID;PathLength;Path\n");
+    
+    // Pour chaque paire de nœuds, dans l'ordre de la liste
+    for (size_t p = 0; p < nodePairs.size(); ++p) {
+        const auto& path = results[p].second;
+        
+        // Écrire dans le CSV : source;cible;longueur à 2 décimales;
+        csvFile.writeInt(nodePairs[p].first);
+        csvFile.put(';');
+        csvFile.writeInt(nodePairs[p].second);
+        csvFile.put(';');
+        csvFile.writeFixed(results[p].first, 2);
+        csvFile.put(';');
+        
+        // Écrire le chemin
+        if (path.empty()) {
+            csvFile.write("No path");
+        } else {
+            for (size_t i = 0; i < path.size(); ++i) {
+                if (i > 0) csvFile.write("->");
+                csvFile.writeInt(path[i]);
+            }
+        }
+        csvFile.put('\n');
+    }
+    if (!csvFile.close()) std::cerr << "Erreur : Écriture incomplète de " << filename << std::endl;
+    Metrics::add(Counter::BytesWritten, csvFile.bytesWritten());
+    
+    std::cout << "Fichier CSV généré : " << filename << std::endl;
+}
+
+// Fonction pour écrire les résultats des chemins les plus courts dans un fichier CSV
+// calcul d'abord (un Dijkstra par source distincte, sources réparties entre
+// les threads), écriture ensuite dans l'ordre des paires
+template <class G>
+void writePathsToCSV(const G& g, const std::vector<NodePair>& nodePairs, const std::string& filename,
+                     unsigned threads = 1, PathMode mode = PathMode::Dijkstra,
+                     const DistanceIndex* index = nullptr) {
+    writePathResultsToCSV(nodePairs, PathQueryEngine<G>(g, index).run(nodePairs, threads, mode), filename);
+}
+
+// Graphe au format Graphviz DOT, octet pour octet comme boost::write_graphviz avec
+// les attributs de generateGraphImage : label = ID du nœud, label = poids à 2 décimales,
+// arêtes du chemin en rouge
+template <class G>
+bool writeGraphDot(const G& g, const std::string& filename) {
+    typedef typename boost::graph_traits<G>::directed_category Category;
+    const bool directed = std::is_convertible<Category, boost::directed_tag>::value;
+    BufferedWriter dot(filename);
+    if (!dot.is_open()) return false;
+    dot.write(directed ? "digraph G {\n" : "graph G {\n");
+    auto ids = get(&NodeInfo::id, g);
+    typename boost::graph_traits<G>::vertex_iterator vi, vi_end;
+    for (boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+        dot.writeInt(static_cast<std::size_t>(*vi));
+        dot.write("[label=\"");
+        dot.writeInt(get(ids, *vi));
+        dot.write("\"];\n");
+    }
+    auto weights = get(&EdgeInfo::weight, g);
+    auto inPath = get(&EdgeInfo::inPath, g);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // edge_iterator orienté de Boost, voir graph_types.hpp
+    typename boost::graph_traits<G>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = edges(g); ei != ei_end; ++ei) {
+        dot.writeInt(static_cast<std::size_t>(source(*ei, g)));
+        dot.write(directed ? "->" : "--");
+        dot.writeInt(static_cast<std::size_t>(target(*ei, g)));
+        dot.write(" [label=\"");
+        dot.writeFixed(get(weights, *ei), 2);
+        dot.put('"');
+        if (get(inPath, *ei)) dot.write(", color=red, penwidth=2");
+        dot.write("];\n");
+    }
+#pragma GCC diagnostic pop
+    dot.write("}\n");
+    bool ok = dot.close();
+    Metrics::add(Counter::BytesWritten, dot.bytesWritten());
+    return ok;
+}
+
+#endif
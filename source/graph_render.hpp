@@ -0,0 +1,258 @@
+#ifndef GRAPH_RENDER_HPP
+#define GRAPH_RENDER_HPP
+
+// Vues réduites du graphe pour l'illustration : au-delà de quelques milliers de nœuds,
+// la mise en page de `dot` ne termine plus, on ne dessine donc qu'une partie bornée
+// - route : voisinage à k sauts des nœuds du chemin en rouge (arêtes inPath)
+// - sample : nœuds du chemin + un nœud sur `pas` jusqu'à maxNodes, arêtes entre eux
+// - components : un nœud par composante connexe (les maxNodes plus grandes), placé au
+//   barycentre de ses nœuds, avec sa taille dans le label
+// - positions : attribut pos="x,y!" tiré des coordonnées des nœuds (ramenées à un
+//   carré de kCanvas points), pour `neato -n` qui n'a alors aucune mise en page à faire
+// - auto : vue complète, ou vue route avec positions pour un PNG trop grand pour `dot`
+// La vue complète sans positions reste écrite par writeGraphDot (graph_io.hpp).
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include "graph_types.hpp"
+#include "connected_components.hpp"
+#include "buffered_writer.hpp"
+#include "metrics.hpp"
+
+// Auto : vue complète, sauf pour un PNG de plus de maxNodes nœuds (vue route avec positions)
+enum class RenderView { Auto, Full, Route, Sample, Components };
+
+struct RenderOptions {
+    RenderView view = RenderView::Auto;
+    bool positions = false;        // pos="x,y!" et rendu PNG par neato -n
+    unsigned hops = 1;             // vue route : rayon du voisinage en nombre d'arêtes
+    std::size_t maxNodes = 5000;   // budget de nœuds des vues réduites (et seuil du PNG complet)
+};
+
+inline bool parseRenderView(const std::string& name, RenderView& view) {
+    if (name == "auto") view = RenderView::Auto;
+    else if (name == "full") view = RenderView::Full;
+    else if (name == "route") view = RenderView::Route;
+    else if (name == "sample") view = RenderView::Sample;
+    else if (name == "components") view = RenderView::Components;
+    else return false;
+    return true;
+}
+
+inline const char* renderViewName(RenderView view) {
+    switch (view) {
+    case RenderView::Route: return "route";
+    case RenderView::Sample: return "sample";
+    case RenderView::Components: return "components";
+    case RenderView::Full: return "full";
+    default: return "auto";
+    }
+}
+
+namespace render_detail {
+
+const double kCanvas = 1000.0;  // côté du dessin en points
+
+// Changement d'échelle des coordonnées (x, y) vers [0, kCanvas], proportions conservées
+struct Projection {
+    double minX = 0, minY = 0, scale = 1;
+
+    template <class G>
+    explicit Projection(const G& g) {
+        auto xs = get(&NodeInfo::x, g);
+        auto ys = get(&NodeInfo::y, g);
+        double maxX = -std::numeric_limits<double>::max(), maxY = maxX;
+        minX = minY = std::numeric_limits<double>::max();
+        typename boost::graph_traits<G>::vertex_iterator vi, vi_end;
+        for (boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+            minX = std::min(minX, get(xs, *vi));
+            maxX = std::max(maxX, get(xs, *vi));
+            minY = std::min(minY, get(ys, *vi));
+            maxY = std::max(maxY, get(ys, *vi));
+        }
+        double extent = std::max(maxX - minX, maxY - minY);
+        scale = extent > 0 ? kCanvas / extent : 1.0;
+    }
+
+    void write(BufferedWriter& out, double x, double y) const {
+        out.write(", pos=\"");
+        out.writeFixed((x - minX) * scale, 2);
+        out.put(',');
+        out.writeFixed((y - minY) * scale, 2);
+        out.write("!\"");
+    }
+};
+
+// Nœuds touchés par une arête du chemin (inPath)
+template <class G>
+std::vector<std::size_t> routeVertices(const G& g, std::vector<char>& keep) {
+    std::vector<std::size_t> route;
+    auto inPath = get(&EdgeInfo::inPath, g);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // edge_iterator orienté de Boost, voir graph_types.hpp
+    typename boost::graph_traits<G>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = edges(g); ei != ei_end; ++ei) {
+        if (!get(inPath, *ei)) continue;
+        for (std::size_t v : { static_cast<std::size_t>(source(*ei, g)), static_cast<std::size_t>(target(*ei, g)) }) {
+            if (!keep[v]) {
+                keep[v] = 1;
+                route.push_back(v);
+            }
+        }
+    }
+#pragma GCC diagnostic pop
+    return route;
+}
+
+// BFS à partir du chemin, arrêté à `hops` sauts ou quand le budget est atteint
+template <class G>
+std::size_t selectRoute(const G& g, const RenderOptions& opt, std::vector<char>& keep) {
+    std::vector<std::size_t> frontier = routeVertices(g, keep);
+    std::size_t kept = frontier.size();
+    std::vector<std::size_t> next;
+    typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+    for (unsigned hop = 0; hop < opt.hops && kept < opt.maxNodes && !frontier.empty(); ++hop) {
+        next.clear();
+        for (std::size_t u : frontier) {
+            for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end && kept < opt.maxNodes; ++ei) {
+                std::size_t v = target(*ei, g);
+                if (keep[v]) continue;
+                keep[v] = 1;
+                ++kept;
+                next.push_back(v);
+            }
+        }
+        frontier.swap(next);
+    }
+    return kept;
+}
+
+// Nœuds du chemin puis un nœud sur `pas`, pour au plus maxNodes nœuds
+template <class G>
+std::size_t selectSample(const G& g, const RenderOptions& opt, std::vector<char>& keep) {
+    const std::size_t n = num_vertices(g);
+    std::size_t kept = routeVertices(g, keep).size();
+    if (kept >= opt.maxNodes) return kept;
+    std::size_t step = std::max<std::size_t>(1, (n + opt.maxNodes - kept - 1) / (opt.maxNodes - kept));
+    for (std::size_t v = 0; v < n && kept < opt.maxNodes; v += step) {
+        if (!keep[v]) {
+            keep[v] = 1;
+            ++kept;
+        }
+    }
+    return kept;
+}
+
+// Sous-graphe induit par keep : mêmes numéros de nœuds et mêmes attributs que la vue complète
+template <class G>
+bool writeSubgraphDot(const G& g, const std::vector<char>& keep, const RenderOptions& opt, const std::string& filename) {
+    const bool directed = boost::is_directed_graph<G>::value;
+    BufferedWriter dot(filename);
+    if (!dot.is_open()) return false;
+    Projection projection(g);
+    auto ids = get(&NodeInfo::id, g);
+    auto xs = get(&NodeInfo::x, g);
+    auto ys = get(&NodeInfo::y, g);
+    dot.write(directed ? "digraph G {\n" : "graph G {\n");
+    typename boost::graph_traits<G>::vertex_iterator vi, vi_end;
+    for (boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+        if (!keep[*vi]) continue;
+        dot.writeInt(static_cast<std::size_t>(*vi));
+        dot.write("[label=\"");
+        dot.writeInt(get(ids, *vi));
+        dot.put('"');
+        if (opt.positions) projection.write(dot, get(xs, *vi), get(ys, *vi));
+        dot.write("];\n");
+    }
+    auto weights = get(&EdgeInfo::weight, g);
+    auto inPath = get(&EdgeInfo::inPath, g);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // edge_iterator orienté de Boost, voir graph_types.hpp
+    typename boost::graph_traits<G>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = edges(g); ei != ei_end; ++ei) {
+        std::size_t u = source(*ei, g), v = target(*ei, g);
+        if (!keep[u] || !keep[v]) continue;
+        dot.writeInt(u);
+        dot.write(directed ? "->" : "--");
+        dot.writeInt(v);
+        dot.write(" [label=\"");
+        dot.writeFixed(get(weights, *ei), 2);
+        dot.put('"');
+        if (get(inPath, *ei)) dot.write(", color=red, penwidth=2");
+        dot.write("];\n");
+    }
+#pragma GCC diagnostic pop
+    dot.write("}\n");
+    bool ok = dot.close();
+    Metrics::add(Counter::BytesWritten, dot.bytesWritten());
+    return ok;
+}
+
+// Un nœud par composante (les maxNodes plus grandes), au barycentre de ses nœuds
+template <class G>
+bool writeComponentsDot(const G& g, const RenderOptions& opt, const std::string& filename, std::size_t& drawn) {
+    ComponentLabels labels = connectedComponentLabels(g);
+    const std::size_t count = labels.count();
+    std::vector<double> cx(count, 0.0), cy(count, 0.0);
+    auto xs = get(&NodeInfo::x, g);
+    auto ys = get(&NodeInfo::y, g);
+    for (std::size_t v = 0; v < labels.component.size(); ++v) {
+        cx[labels.component[v]] += get(xs, v);
+        cy[labels.component[v]] += get(ys, v);
+    }
+    std::vector<std::size_t> order(count);
+    for (std::size_t c = 0; c < count; ++c) order[c] = c;
+    drawn = std::min(count, opt.maxNodes);
+    std::partial_sort(order.begin(), order.begin() + drawn, order.end(), [&labels](std::size_t a, std::size_t b) {
+        return labels.sizes[a] != labels.sizes[b] ? labels.sizes[a] > labels.sizes[b] : a < b;
+    });
+    std::sort(order.begin(), order.begin() + drawn);
+
+    BufferedWriter dot(filename);
+    if (!dot.is_open()) return false;
+    Projection projection(g);
+    dot.write("graph G {\n");
+    for (std::size_t k = 0; k < drawn; ++k) {
+        std::size_t c = order[k];
+        dot.writeInt(c);
+        dot.write("[label=\"C");
+        dot.writeInt(c);
+        dot.write(" (");
+        dot.writeInt(labels.sizes[c]);
+        dot.write(")\"");
+        if (opt.positions) projection.write(dot, cx[c] / labels.sizes[c], cy[c] / labels.sizes[c]);
+        dot.write("];\n");
+    }
+    dot.write("}\n");
+    bool ok = dot.close();
+    Metrics::add(Counter::BytesWritten, dot.bytesWritten());
+    return ok;
+}
+
+} // namespace render_detail
+
+// Écrit la vue demandée ; drawn = nombre de nœuds dessinés (composantes pour la vue components)
+template <class G>
+bool writeGraphView(const G& g, const RenderOptions& opt, const std::string& filename, std::size_t& drawn) {
+    const std::size_t n = num_vertices(g);
+    if (opt.view == RenderView::Components) return render_detail::writeComponentsDot(g, opt, filename, drawn);
+    std::vector<char> keep(n, 0);
+    switch (opt.view) {
+    case RenderView::Route:
+        drawn = render_detail::selectRoute(g, opt, keep);
+        if (drawn == 0) drawn = render_detail::selectSample(g, opt, keep);  // pas de chemin : échantillon
+        break;
+    case RenderView::Sample: drawn = render_detail::selectSample(g, opt, keep); break;
+    default:
+        std::fill(keep.begin(), keep.end(), 1);
+        drawn = n;
+        break;
+    }
+    return render_detail::writeSubgraphDot(g, keep, opt, filename);
+}
+
+#endif
@@ -0,0 +1,299 @@
+#ifndef GRAPH_SNAPSHOT_HPP
+#define GRAPH_SNAPSHOT_HPP
+
+// Snapshot binaire d'un graphe figé (CsrGraph) pour démarrer sans relire les CSV
+// Le fichier contient un en-tête de 64 octets puis les tableaux du CSR tels qu'ils
+// sont en mémoire, chacun aligné sur 64 octets :
+//   ids (int64, n) | x, y, z (double, n) | offsets (n + 1) | cibles (2m) |
+//   numéros d'arête (2m) | sources (m) | cibles des arêtes (m) | poids (m)
+// Indices sur 64 ou 32 bits et poids double ou float selon la configuration du graphe
+// (graph_config.hpp), notée dans l'en-tête ; en orienté les cibles n'ont que m cases et
+// les numéros d'arête et cibles des arêtes sont absents. Le chargement choisit
+// l'instanciation d'après l'en-tête (snapshotConfig).
+// Au chargement le fichier est projeté (mmap) et le CsrGraph pointe directement dans
+// la projection : pas de parsing, pas de copie, les pages sont lues à la demande.
+// Seule la correspondance ID -> indice (node_ids.hpp) est reconstruite, en une passe
+// sur les IDs (aucune table quand ils sont consécutifs).
+// L'en-tête porte une version, la taille attendue du fichier et deux sommes de contrôle
+// (en-tête et données) ; celle des données n'est vérifiée que sur demande car elle
+// oblige à lire tout le fichier. Sans elle, une passe O(n + m) sur la structure
+// (offsets croissants, cibles, numéros d'arête et extrémités dans les bornes, poids
+// finis et positifs, que les recherches de plus court chemin supposent) refuse
+// un fichier abîmé avant qu'un parcours ne lise hors des tableaux.
+// Format natif : little-endian, size_t 64 bits.
+// Un snapshot écrit avant les configurations (champ à zéro) est non orienté, double, 64 bits.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "csr_graph.hpp"
+#include "graph_config.hpp"
+#include "csv_mmap.hpp"
+
+static_assert(sizeof(std::size_t) == 8, "le format de snapshot suppose des indices 64 bits");
+
+// Somme de contrôle par blocs de 32 octets : 4 accumulateurs indépendants
+// (multiplication-xor façon FNV sur des mots de 64 bits) pour ne pas être limité
+// par la latence d'une seule chaîne de multiplications
+class SnapshotChecksum {
+public:
+    // bytes doit être un multiple de 32 (les sections sont alignées sur 64)
+    void update(const char* p, std::size_t bytes) {
+        for (std::size_t i = 0; i + 32 <= bytes; i += 32) {
+            for (int k = 0; k < 4; ++k) {
+                std::uint64_t w;
+                std::memcpy(&w, p + i + 8 * k, 8);
+                _h[k] = (_h[k] ^ w) * 0x100000001b3ULL;
+                _h[k] ^= _h[k] >> 29;
+            }
+        }
+    }
+    std::uint64_t value() const {
+        std::uint64_t h = 1469598103934665603ULL;
+        for (int k = 0; k < 4; ++k) h = (h ^ _h[k]) * 0x100000001b3ULL;
+        return h;
+    }
+private:
+    std::uint64_t _h[4] = { 1469598103934665603ULL, 0x9e3779b97f4a7c15ULL,
+                            0xc2b2ae3d27d4eb4fULL, 0x165667b19e3779f9ULL };
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint64_t vertices;
+    std::uint64_t edges;
+    std::uint64_t fileSize;
+    std::uint64_t dataChecksum;    // sur tout ce qui suit l'en-tête, padding compris
+    std::uint64_t headerChecksum;  // sur l'en-tête avec ce champ à zéro
+    std::uint64_t config;          // drapeaux GraphLayout (0 : non orienté, double, 64 bits)
+};
+static_assert(sizeof(SnapshotHeader) == 64, "en-tête de snapshot sur 64 octets");
+
+constexpr char kSnapshotMagic[8] = { 'G', 'C', 'P', 'P', 'S', 'N', 'A', 'P' };
+constexpr std::uint32_t kSnapshotVersion = 2;  // 2 : IDs sur 64 bits
+constexpr std::size_t kSnapshotAlign = 64;
+
+// Position de chaque tableau dans le fichier, déduite de n, m et de la configuration
+struct SnapshotLayout {
+    std::uint64_t ids, x, y, z, offsets, targets, slotEdge, edgeSource, edgeTarget, weight, fileSize;
+
+    SnapshotLayout(std::uint64_t n, std::uint64_t m, std::uint64_t config) {
+        const bool directed = config & GraphLayout::kDirected;
+        const std::uint64_t index = config & GraphLayout::kNarrowIndex ? 4 : 8;
+        const std::uint64_t weightSize = config & GraphLayout::kFloatWeights ? 4 : 8;
+        const std::uint64_t slots = directed ? m : 2 * m;
+        std::uint64_t pos = sizeof(SnapshotHeader);
+        auto section = [&pos](std::uint64_t bytes) {
+            std::uint64_t at = pos;
+            pos += (bytes + kSnapshotAlign - 1) / kSnapshotAlign * kSnapshotAlign;
+            return at;
+        };
+        ids = section(n * sizeof(NodeId));
+        x = section(n * sizeof(double));
+        y = section(n * sizeof(double));
+        z = section(n * sizeof(double));
+        offsets = section((n + 1) * index);
+        targets = section(slots * index);
+        slotEdge = section(directed ? 0 : slots * index);
+        edgeSource = section(m * index);
+        edgeTarget = section(directed ? 0 : m * index);
+        weight = section(m * weightSize);
+        fileSize = pos;
+    }
+};
+
+inline std::uint64_t snapshotHeaderChecksum(SnapshotHeader h) {
+    h.headerChecksum = 0;
+    SnapshotChecksum sum;
+    sum.update(reinterpret_cast<const char*>(&h), sizeof h);
+    return sum.value();
+}
+
+// Accès aux tableaux du CSR (ami de BasicCsrGraph)
+struct SnapshotIo {
+    // Écrit le graphe ; les données passent une seule fois, la somme de contrôle
+    // est calculée au fil de l'écriture puis l'en-tête est réécrit à la fin
+    template <class C>
+    static bool save(const BasicCsrGraph<C>& g, const std::string& filename) {
+        typedef typename C::index_type Index;
+        typedef typename C::weight_type Weight;
+        std::FILE* f = std::fopen(filename.c_str(), "wb");
+        if (!f) return false;
+        const std::uint64_t n = g.vertexCount(), m = g.edgeCount();
+        const std::uint64_t slots = C::directed ? m : 2 * m;
+
+        SnapshotHeader h;
+        std::memset(&h, 0, sizeof h);
+        std::copy(kSnapshotMagic, kSnapshotMagic + 8, h.magic);
+        h.version = kSnapshotVersion;
+        h.headerSize = sizeof h;
+        h.vertices = n;
+        h.edges = m;
+        h.config = configFlags<C>();
+        h.fileSize = SnapshotLayout(n, m, h.config).fileSize;
+        bool ok = std::fwrite(&h, sizeof h, 1, f) == 1;
+
+        SnapshotChecksum sum;
+        auto writeSection = [&](const void* data, std::size_t bytes) {
+            if (!ok) return;
+            // les octets complets passent directement, le reste est complété par des zéros
+            std::size_t whole = bytes / kSnapshotAlign * kSnapshotAlign;
+            ok = whole == 0 || std::fwrite(data, 1, whole, f) == whole;
+            sum.update(static_cast<const char*>(data), whole);
+            if (ok && whole < bytes) {
+                char tail[kSnapshotAlign] = {};
+                std::memcpy(tail, static_cast<const char*>(data) + whole, bytes - whole);
+                ok = std::fwrite(tail, 1, kSnapshotAlign, f) == kSnapshotAlign;
+                sum.update(tail, kSnapshotAlign);
+            }
+        };
+        writeSection(g._ids.data(), n * sizeof(NodeId));
+        writeSection(g._coords.x.data(), n * sizeof(double));
+        writeSection(g._coords.y.data(), n * sizeof(double));
+        writeSection(g._coords.z.data(), n * sizeof(double));
+        writeSection(g._offsets.data(), (n + 1) * sizeof(Index));
+        writeSection(g._targets.data(), slots * sizeof(Index));
+        if (!C::directed) writeSection(g._slotEdge.data(), slots * sizeof(Index));
+        writeSection(g._edgeSource.data(), m * sizeof(Index));
+        if (!C::directed) writeSection(g._edgeTarget.data(), m * sizeof(Index));
+        writeSection(g._weight.data(), m * sizeof(Weight));
+
+        h.dataChecksum = sum.value();
+        h.headerChecksum = snapshotHeaderChecksum(h);
+        ok = ok && std::fseek(f, 0, SEEK_SET) == 0 && std::fwrite(&h, sizeof h, 1, f) == 1;
+        return std::fclose(f) == 0 && ok;
+    }
+
+    // Projette un snapshot et fait pointer g dans la projection (copie à l'écriture :
+    // --coords peut réécrire coordonnées et poids sans toucher au fichier)
+    // verify : recalcule la somme de contrôle des données (lit tout le fichier)
+    template <class C>
+    static bool load(const std::string& filename, BasicCsrGraph<C>& g, bool verify) {
+        typedef typename C::index_type Index;
+        typedef typename C::weight_type Weight;
+        auto file = std::make_shared<MappedFile>();
+        SnapshotHeader h;
+        if (!openHeader(filename, *file, h)) return false;
+        if (h.config != configFlags<C>()) {
+            std::cerr << "Erreur : snapshot " << filename << " d'une autre configuration de graphe" << std::endl;
+            return false;
+        }
+        const std::uint64_t n = h.vertices, m = h.edges;
+        const std::uint64_t slots = C::directed ? m : 2 * m;
+        SnapshotLayout layout(n, m, h.config);
+        if (n > file->size() || m > file->size() || h.fileSize != layout.fileSize || file->size() != layout.fileSize) {
+            std::cerr << "Erreur : snapshot " << filename << " tronqué" << std::endl;
+            return false;
+        }
+        char* base = file->data();
+        if (verify) {
+            SnapshotChecksum sum;
+            sum.update(base + sizeof h, file->size() - sizeof h);
+            if (sum.value() != h.dataChecksum) {
+                std::cerr << "Erreur : somme de contrôle invalide pour le snapshot " << filename << std::endl;
+                return false;
+            }
+        }
+        Index* offsets = reinterpret_cast<Index*>(base + layout.offsets);
+        if (!structureValid<Index, Weight>(base, layout, n, m, C::directed)) {
+            std::cerr << "Erreur : snapshot " << filename << " incohérent" << std::endl;
+            return false;
+        }
+
+        g = BasicCsrGraph<C>();
+        g._ids.view(reinterpret_cast<NodeId*>(base + layout.ids), n);
+        const NodeId* ids = g._ids.data();
+        g._idMap = NodeIdMap(n, [ids](std::size_t v) { return ids[v]; });
+        g._coords.x.view(reinterpret_cast<double*>(base + layout.x), n);
+        g._coords.y.view(reinterpret_cast<double*>(base + layout.y), n);
+        g._coords.z.view(reinterpret_cast<double*>(base + layout.z), n);
+        g._offsets.view(offsets, n + 1);
+        g._targets.view(reinterpret_cast<Index*>(base + layout.targets), slots);
+        if (!C::directed) g._slotEdge.view(reinterpret_cast<Index*>(base + layout.slotEdge), slots);
+        g._edgeSource.view(reinterpret_cast<Index*>(base + layout.edgeSource), m);
+        if (!C::directed) g._edgeTarget.view(reinterpret_cast<Index*>(base + layout.edgeTarget), m);
+        g._weight.view(reinterpret_cast<Weight*>(base + layout.weight), m);
+        g._inPath.resize(m);  // pas stocké : aucun chemin surligné au chargement
+        g._storage = file;
+        return true;
+    }
+
+    // Passe sur la structure : offsets croissants de 0 à slots, cibles et extrémités
+    // des arêtes < n, numéros d'arête des cases < m, poids finis et >= 0
+    template <class Index, class Weight>
+    static bool structureValid(const char* base, const SnapshotLayout& layout, std::uint64_t n, std::uint64_t m,
+                               bool directed) {
+        const std::uint64_t slots = directed ? m : 2 * m;
+        const Index* offsets = reinterpret_cast<const Index*>(base + layout.offsets);
+        if (offsets[0] != 0 || offsets[n] != slots) return false;
+        for (std::uint64_t v = 0; v < n; ++v) {
+            if (offsets[v + 1] < offsets[v]) return false;
+        }
+        auto below = [base](std::uint64_t at, std::uint64_t count, std::uint64_t bound) {
+            const Index* values = reinterpret_cast<const Index*>(base + at);
+            for (std::uint64_t i = 0; i < count; ++i) {
+                if (values[i] >= bound) return false;
+            }
+            return true;
+        };
+        const Weight* weights = reinterpret_cast<const Weight*>(base + layout.weight);
+        for (std::uint64_t e = 0; e < m; ++e) {
+            if (!(weights[e] >= 0) || !std::isfinite(weights[e])) return false;
+        }
+        if (!below(layout.targets, slots, n) || !below(layout.edgeSource, m, n)) return false;
+        return directed || (below(layout.slotEdge, slots, m) && below(layout.edgeTarget, m, n));
+    }
+
+    // Ouvre le fichier et valide l'en-tête (magic, somme de contrôle, version)
+    static bool openHeader(const std::string& filename, MappedFile& file, SnapshotHeader& h) {
+        if (!file.open(filename, true)) {
+            std::cerr << "Erreur lors de l'ouverture du fichier " << filename << std::endl;
+            return false;
+        }
+        if (file.size() < sizeof h) {
+            std::cerr << "Erreur : snapshot " << filename << " tronqué" << std::endl;
+            return false;
+        }
+        std::memcpy(&h, file.begin(), sizeof h);
+        if (!std::equal(kSnapshotMagic, kSnapshotMagic + 8, h.magic) || h.headerSize != sizeof h ||
+            h.headerChecksum != snapshotHeaderChecksum(h)) {
+            std::cerr << "Erreur : " << filename << " n'est pas un snapshot de graphe valide" << std::endl;
+            return false;
+        }
+        if (h.version != kSnapshotVersion) {
+            std::cerr << "Erreur : snapshot " << filename << " en version " << h.version
+                      << " (version attendue " << kSnapshotVersion << ")" << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+template <class C>
+bool saveSnapshot(const BasicCsrGraph<C>& g, const std::string& filename) {
+    return SnapshotIo::save(g, filename);
+}
+
+template <class C>
+bool loadSnapshot(const std::string& filename, BasicCsrGraph<C>& g, bool verify = false) {
+    return SnapshotIo::load(filename, g, verify);
+}
+
+// Configuration d'un snapshot (drapeaux GraphLayout), lue dans l'en-tête seul
+inline bool snapshotConfig(const std::string& filename, std::uint64_t& config) {
+    MappedFile file;
+    SnapshotHeader h;
+    if (!SnapshotIo::openHeader(filename, file, h)) return false;
+    config = h.config;
+    return true;
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef GRAPH_SUMMARY_HPP
+#define GRAPH_SUMMARY_HPP
+
+// Analyse fusionnée pour le rapport : un seul parcours des listes d'adjacence calcule
+// les degrés (par nœud, histogramme, maximum) et alimente l'union-find des composantes ;
+// la présence d'un cycle s'en déduit sans parcours (E > V - C, voir cycle_detection.hpp).
+// Graphe orienté : degrés sortants, composantes faiblement connexes, et le décompte ne
+// dit rien des cycles orientés : ils sont cherchés par parcours en profondeur.
+// Les tableaux de travail (union-find, histogrammes par thread) sont gardés dans
+// AnalysisScratch et réutilisés d'une analyse à l'autre.
+// writeSummaryJson écrit le résultat sous forme de rapport structuré (JSON).
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include "connected_components.hpp"
+#include "cycle_detection.hpp"
+#include "metrics.hpp"
+
+struct GraphSummary {
+    bool directed = false;
+    std::size_t vertices = 0;
+    std::size_t edges = 0;
+    std::vector<std::size_t> degree;           // n : degré de chaque nœud (sortant en orienté)
+    std::vector<std::size_t> degreeHistogram;  // [d] : nombre de nœuds de degré d
+    std::size_t maxDegree = 0;
+    ComponentLabels components;
+    bool hasCycle = false;
+
+    bool connected() const { return components.count() == 1; }
+};
+
+struct AnalysisScratch {
+    ConcurrentUnionFind unionFind;
+    std::vector<std::vector<std::size_t>> histograms;  // un par thread
+};
+
+// threads = 0 : tous les coeurs
+template <class G>
+void summarizeGraph(const G& g, GraphSummary& summary, AnalysisScratch& scratch, unsigned threads = 1) {
+    ScopedPhase phase(Phase::Analysis);
+    const std::size_t n = num_vertices(g);
+    const bool directed = boost::is_directed_graph<G>::value;
+    threads = componentThreads(n, threads);
+    summary.directed = directed;
+    summary.vertices = n;
+    summary.edges = num_edges(g);
+    summary.degree.resize(n);
+    scratch.unionFind.reset(n);
+    scratch.histograms.resize(threads);
+
+    // le seul passage sur les arêtes : degré de u et union de u avec ses voisins v > u
+    // (avec tous ses successeurs en orienté)
+    forEachVertexRange(n, threads, [&](std::size_t begin, std::size_t end, unsigned t) {
+        std::vector<std::size_t>& histogram = scratch.histograms[t];
+        histogram.clear();
+        typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+        for (std::size_t u = begin; u < end; ++u) {
+            std::size_t d = 0;
+            for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei, ++d) {
+                std::size_t v = target(*ei, g);
+                if (directed || u < v) scratch.unionFind.unite(u, v);
+            }
+            summary.degree[u] = d;
+            if (histogram.size() <= d) histogram.resize(d + 1, 0);
+            ++histogram[d];
+        }
+    });
+
+    summary.degreeHistogram.clear();
+    for (const auto& histogram : scratch.histograms) {
+        if (summary.degreeHistogram.size() < histogram.size()) summary.degreeHistogram.resize(histogram.size(), 0);
+        for (std::size_t d = 0; d < histogram.size(); ++d) summary.degreeHistogram[d] += histogram[d];
+    }
+    summary.maxDegree = summary.degreeHistogram.empty() ? 0 : summary.degreeHistogram.size() - 1;
+
+    labelComponents(scratch.unionFind, n, threads, summary.components);
+    summary.hasCycle = directed ? !findCycle(g).empty() : hasCycleByCount(g, summary.components);
+}
+
+template <class G>
+GraphSummary summarizeGraph(const G& g, unsigned threads = 1) {
+    GraphSummary summary;
+    AnalysisScratch scratch;
+    summarizeGraph(g, summary, scratch, threads);
+    return summary;
+}
+
+// Rapport structuré : tailles, histogramme des degrés (degrés présents seulement),
+// composantes (nombre, plus grande, répartition des tailles par puissances de 2), cycle
+inline bool writeSummaryJson(const GraphSummary& summary, const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) return false;
+    out << "{\n";
+    if (summary.directed) out << "  \"directed\": true,\n";
+    out << "  \"vertices\": " << summary.vertices << ",\n";
+    out << "  \"edges\": " << summary.edges << ",\n";
+    out << "  \"degree\": {\n";
+    out << "    \"max\": " << summary.maxDegree << ",\n";
+    out << "    \"histogram\": [";
+    bool first = true;
+    for (std::size_t d = 0; d < summary.degreeHistogram.size(); ++d) {
+        if (summary.degreeHistogram[d] == 0) continue;
+        out << (first ? "" : ", ") << "{\"degree\": " << d << ", \"count\": " << summary.degreeHistogram[d] << "}";
+        first = false;
+    }
+    out << "]\n  },\n";
+    out << "  \"components\": {\n";
+    out << "    \"count\": " << summary.components.count() << ",\n";
+    out << "    \"largest\": " << summary.components.largest() << ",\n";
+    out << "    \"size_histogram\": [";
+    std::vector<std::size_t> buckets = componentSizeBuckets(summary.components);
+    first = true;
+    for (std::size_t b = 0; b < buckets.size(); ++b) {
+        if (buckets[b] == 0) continue;
+        out << (first ? "" : ", ") << "{\"min\": " << (std::size_t(1) << b) << ", \"max\": "
+            << ((std::size_t(2) << b) - 1) << ", \"count\": " << buckets[b] << "}";
+        first = false;
+    }
+    out << "]\n  },\n";
+    out << "  \"connected\": " << (summary.connected() ? "true" : "false") << ",\n";
+    out << "  \"has_cycle\": " << (summary.hasCycle ? "true" : "false") << "\n";
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef GRAPH_TYPES_HPP
+#define GRAPH_TYPES_HPP
+
+// Types communs du graphe (partagés par main2.cpp et les autres représentations)
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+// GCC signale à tort -Wmaybe-uninitialized dans l'adjacency_list (edge_iterator de la
+// version orientée, qui contient un boost::optional ; propriété par défaut de add_edge) :
+// avertissement coupé pour les en-têtes de Boost ici, et
+// autour des boucles sur edges(g) où il remonte dans notre code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <boost/graph/adjacency_list.hpp>
+#pragma GCC diagnostic pop
+#include <boost/graph/graph_traits.hpp>
+#include "node_ids.hpp"
+
+// Structure pour stocker les informations d'un nœud
+struct NodeInfo {
+    NodeId id;  // ID du CSV, quelconque (voir node_ids.hpp)
+    double x, y, z;
+};
+
+// Structure pour stocker les propriétés des arêtes
+struct EdgeInfo {
+    double weight;
+    bool inPath;  // Pour le path court
+};
+
+// Définition du type de graphe
+template <class Directed>
+using BasicGraph = boost::adjacency_list<
+    boost::vecS,           // Conteneur pour les arêtes sortantes
+    boost::vecS,           // Conteneur pour les sommets
+    Directed,              // boost::undirectedS ou boost::directedS
+    NodeInfo,              // Structur pour les nœuds
+    EdgeInfo,       // Struct pour les arêtes
+    NodeIdMap       // Propriété du graphe : ID du CSV -> indice du sommet
+>;
+
+typedef BasicGraph<boost::undirectedS> Graph;          // Graphe non orienté
+typedef BasicGraph<boost::directedS> DirectedGraph;    // --directed : arcs Source -> Target
+
+typedef boost::graph_traits<Graph>::vertex_descriptor Vertex;
+typedef boost::graph_traits<Graph>::edge_descriptor Edge;
+
+// Requête de chemin : paire d'IDs du CSV (départ, arrivée)
+typedef std::pair<NodeId, NodeId> NodePair;
+
+// Résultat d'une requête de chemin : longueur (-1 si pas de chemin) et suite des IDs du CSV
+typedef std::pair<double, std::vector<NodeId>> PathResult;
+
+template <class D>
+NodeIdMap& nodeIdMap(BasicGraph<D>& g) { return g[boost::graph_bundle]; }
+template <class D>
+const NodeIdMap& nodeIdMap(const BasicGraph<D>& g) { return g[boost::graph_bundle]; }
+
+// Indice du sommet d'ID id (NodeIdMap::npos si l'ID est inconnu), pour tout graphe
+// qui fournit nodeIdMap(g) (adjacency_list, CsrGraph)
+template <class G>
+std::size_t nodeIndex(const G& g, NodeId id) {
+    return nodeIdMap(g).vertex(id, num_vertices(g));
+}
+
+// Reconstruit la correspondance après avoir rempli ou renuméroté les nœuds
+template <class D>
+void rebuildNodeIdMap(BasicGraph<D>& g) {
+    nodeIdMap(g) = NodeIdMap(boost::num_vertices(g), [&g](std::size_t v) { return g[v].id; });
+}
+
+#endif
@@ -5,402 +5,451 @@
 #include <chrono>
 #include <utility>
 #include <iomanip>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/graph_traits.hpp>
-#include <boost/graph/connected_components.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/graph/depth_first_search.hpp>
-#include <boost/graph/graphviz.hpp>
-#include <boost/tokenizer.hpp>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <charconv>
+#include <unistd.h>
+#include "csv_mmap.hpp"
+#include "weights_simd.hpp"
+#include "graph_types.hpp"
+#include "graph_config.hpp"
+#include "csr_graph.hpp"
+#include "graph_snapshot.hpp"
+#include "graph_io.hpp"
+#include "dynamic_graph.hpp"
+#include "metrics.hpp"
+#include "vertex_order.hpp"
+#include "graph_analysis.hpp"
 
-// Structure pour stocker les informations d'un nœud
-struct NodeInfo {
-    int id;
-    double x, y, z;
-};
+// Chargement et fichiers de sortie : graph_io.hpp ; connectivité, cycle et chemins :
+// graph_algorithms.hpp ; rapport et suite de l'analyse : graph_analysis.hpp. Les fonctions
+// d'analyse sont des templates : elles acceptent l'adjacency_list (Graph, DirectedGraph)
+// comme le graphe figé BasicCsrGraph (voir csr_graph.hpp), dont la configuration (orientation,
+// type des poids, largeur des indices) est choisie ici à l'exécution
 
-// Structure pour stocker les propriétés des arêtes
-struct EdgeInfo {
-    double weight;
-    bool inPath;  // Pour le path court
-};
-
-// Définition du type de graphe
-typedef boost::adjacency_list<
-    boost::vecS,           // Conteneur pour les arêtes sortantes
-    boost::vecS,           // Conteneur pour les sommets
-    boost::undirectedS,    // Graphe non orienté
-    NodeInfo,              // Structur pour les nœuds
-    EdgeInfo        // Struct pour les arêtes
-> Graph;
-
-typedef boost::graph_traits<Graph>::vertex_descriptor Vertex;
-typedef boost::graph_traits<Graph>::edge_descriptor Edge;
+// Valeur numérique d'une option (--threads=N, --start=N...) : toute la valeur doit être un
+// nombre du type attendu (pas de signe pour les non signés, pas de dépassement)
+template <class T>
+bool parseOptionNumber(const std::string& arg, size_t prefix, T& value) {
+    const char* first = arg.data() + prefix;
+    const char* last = arg.data() + arg.size();
+    if (first < last && *first == '+') ++first;
+    std::from_chars_result r = std::from_chars(first, last, value);
+    if (r.ec == std::errc() && r.ptr == last && first != last) return true;
+    std::cerr << "Valeur numérique inconnue : " << arg.substr(prefix) << " (" << arg.substr(0, prefix) << "N)" << std::endl;
+    return false;
+}
 
-// visiteur pour détecter les cycles
-// algorythme depth first car + rapide
-class CycleDetector : public boost::dfs_visitor<> {
-public:
-    CycleDetector(bool& hasCycle) : _hasCycle(hasCycle) {}
-    /*CycleDetector(bool& hasCycle) {
-        // Initialize the member variable _hasCycle with the value of hasCycle
-        _hasCycle = hasCycle;
-    }*/
-    // Examine les arêtes arrières pour détecter les cycles
-    template <class Edge, class Graph>
-    void back_edge(Edge, const Graph&) {
-        _hasCycle = true;
-    }
-private:
-    bool& _hasCycle;
-};
+const char* const kUsage =
+    "usage : graph_analysis [nodes.csv] [edges.csv] [paths.csv] [graph.dot] [--option...] (options : voir README.md)\n"
+    "        graph_analysis snapshot nodes.csv edges.csv [graph.snap] [--option...]";
 
-// Fonctions pour charger les données
-std::vector<NodeInfo> loadNodes(const std::string& filename) {
-    std::vector<NodeInfo> nodes; // on fabrique un vecteur remplie de nodeInfo pour stocker la data
-    std::ifstream file(filename);
-    
-    // verification classique si le fichier est bien là
-    if (!file.is_open()) {
-        std::cerr << "Erreur lors de l'ouverture du fichier " << filename << std::endl;
-        return nodes;
-    }
-    
-    std::string line;
-    
-    // Ignorer la première ligne (en-têtes)
-    std::getline(file, line);
-    // Parcour le reste du fichier
-    while (std::getline(file, line)) {
-        boost::char_separator<char> sep(";"); // defini ; comme separateur
-        boost::tokenizer<boost::char_separator<char>> tokens(line, sep); // split la ligne en par ";"
+// --insert / --delete : applique les fichiers de mise à jour dans l'ordre sur le graphe
+// déjà analysé ; connectivité et chemins sont entretenus par DynamicGraph
+// (dynamic_graph.hpp), paths.csv et components.csv sont réécrits à la fin
+void applyDeltas(Graph& g, const RunOptions& opt) {
+    std::cout << "\n== Mises à jour incrémentales ==" << std::endl;
+    DynamicGraph dynamic(g, opt.threads);
+    std::vector<NodePair> nodePairs = analysisNodePairs(g);
+    std::vector<PathResult> results = dynamic.paths(nodePairs, opt.query_threads, opt.path_mode);
+    NodeCoords coords = nodeCoordsOf(g);
+    
+    for (const auto& delta : opt.deltas) {
+        EdgeBatch batch;
+        if (!loadEdgeDelta(coords, nodeIdMap(g), delta.second, batch)) continue;
+        DynamicGraph::UpdateStats stats = delta.first ? dynamic.insertEdges(batch) : dynamic.deleteEdges(batch);
+        std::cout << delta.second << " : " << stats.applied << " arête(s) " << (delta.first ? "ajoutée(s)" : "retirée(s)");
+        if (stats.ignored > 0) std::cout << ", " << stats.ignored << " absente(s)";
+        std::cout << " en " << stats.milliseconds << " ms" << std::endl;
         
-        auto tok = tokens.begin(); //pointeur de départ
-        if (tok != tokens.end()) {
-            NodeInfo node; // creation new node
-            node.id = std::stoi(*tok++); // 1er colonne = ID
-            if (tok != tokens.end()) node.x = std::stod(*tok++);
-            if (tok != tokens.end()) node.y = std::stod(*tok++);
-            if (tok != tokens.end()) node.z = std::stod(*tok++);
-            
-            nodes.push_back(node);
-        }
+        // réanalyse : connectivité (reconstruite seulement si une composante a pu être coupée)
+        // et chemins invalidés par ce lot
+        auto t0 = std::chrono::high_resolution_clock::now();
+        size_t recomputed = 0;
+        results = dynamic.paths(nodePairs, opt.query_threads, opt.path_mode, &recomputed);
+        size_t count = dynamic.componentCount();
+        bool cycle = dynamic.hasCycle();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std::cout << "    composantes connexes: " << count << ", cycle: " << (cycle ? "oui" : "non")
+                  << ", chemins recalculés: " << recomputed << "/" << nodePairs.size() << " en "
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
     }
     
-    return nodes;
+    writePathResultsToCSV(nodePairs, results, opt.output_csv);
+    writeComponentsToCSV(g, dynamic.components(), componentsFileFor(opt.output_csv));
 }
 
-// voir loadNodes car c'est pareil
-// ! le graph est dejà fait, on ajoute juste arretes
-// d'ou le void
-void loadEdges(Graph& g, const std::string& filename) {
-    std::ifstream file(filename);
-    
-    if (!file.is_open()) {
-        std::cerr << "Erreur durant l'ouverture du fichier " << filename << std::endl;
-        return;
-    }
-    
-    std::string line;
-    
-    std::getline(file, line);
-    
-    while (std::getline(file, line)) {
-        boost::char_separator<char> sep(";");
-        boost::tokenizer<boost::char_separator<char>> tokens(line, sep);
-        
-        auto tok = tokens.begin();
-        if (tok != tokens.end()) {
-            int source = std::stoi(*tok++) - 1;  // -1 car les ID commencent lign1 dans le fichier csv
-            if (tok != tokens.end()) {
-                int target = std::stoi(*tok++) - 1;  // mais les indices dans le graphe commencent à 0
-                
-                // Vérifier si les indices sont valides
-                if (source >= 0 && source < boost::num_vertices(g) && 
-                    target >= 0 && target < boost::num_vertices(g)) {
-                    // Calculer le poids de l'arête (distance euclidienne 3D)
-                    double dx = g[source].x - g[target].x;
-                    double dy = g[source].y - g[target].y;
-                    double dz = g[source].z - g[target].z;
-                    // pythogore
-                    double weight = std::sqrt(dx*dx + dy*dy + dz*dz);
-                    
-                    // Ajouter l'arête au graphe avec son poids
-                    Edge e;
-                    bool inserted;
-                    boost::tie(e, inserted) = boost::add_edge(source, target, g);
-                    if (inserted) {
-                        g[e].weight = weight;
-                        g[e].inPath = false;
-                    }
-                }
-            }
-        }
+// Fige g en CSR dans la configuration Config (orientation de g, poids et indices choisis
+// à l'exécution) ; l'adjacency_list est libérée aussitôt
+template <class Config, class Source>
+void freezeGraph(Source& g, BasicCsrGraph<Config>& frozen) {
+    ScopedPhase phase(Phase::FreezeCsr);
+    frozen = BasicCsrGraph<Config>(g);
+    g = Source();
+    std::cout << "Graphe figé en CSR (" << configName<Config>() << ") : " << std::fixed << std::setprecision(1)
+              << frozen.memoryBytes() / (1024.0 * 1024.0) << " Mo" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+// --snapshot : graphe CSR projeté directement depuis le fichier binaire, dans la
+// configuration enregistrée dans son en-tête
+template <class Config>
+bool analyzeSnapshot(const std::string& snapshot_file, bool verify, const RunOptions& opt) {
+    BasicCsrGraph<Config> frozen;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    {
+        ScopedPhase phase(Phase::LoadSnapshot);
+        if (!loadSnapshot(snapshot_file, frozen, verify)) return false;
     }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::cout << "Chargement snapshot " << snapshot_file << " : " << frozen.vertexCount() << " nœuds, "
+              << frozen.edgeCount() << " arêtes (" << configName<Config>() << ") en "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+    runAnalysis(frozen, opt);
+    return true;
 }
 
-// Fonction pour vérifier si le graphe est connecté
-bool isConnected(const Graph& g) {
-    std::vector<int> component(boost::num_vertices(g));
-    int num_components = boost::connected_components(g, &component[0]);
-    return num_components == 1;
+// Chargement des CSV dans l'adjacency_list (orientée ou non), renumérotation, puis analyse
+// sur l'adjacency_list ou, avec use_csr, sur le CSR de la configuration choisie par layout
+template <class D>
+bool analyzeCsvGraph(const std::string& nodes_file, const std::string& edges_file, VertexOrder order,
+                     bool use_csr, const GraphLayout& layout, const RunOptions& opt) {
+    typedef typename boost::graph_traits<BasicGraph<D>>::directed_category Directed;
+    BasicGraph<D> g;
+    if (!loadCsvGraph(g, nodes_file, edges_file, opt.threads)) return false;
+    reorderVertices(g, order);  // --reorder : voisins rapprochés en mémoire
+    
+    // --csr : la topologie ne change plus, on fige le graphe en CSR
+    // et on libère l'adjacency_list avant l'analyse
+    if (use_csr) {
+        withGraphConfigOf<Directed>(layout.flagsFor(boost::num_vertices(g), boost::num_edges(g)), [&](auto config) {
+            BasicCsrGraph<decltype(config)> frozen;
+            freezeGraph(g, frozen);
+            runAnalysis(frozen, opt);
+        });
+    } else {
+        runAnalysis(g, opt);
+    }
+    return true;
 }
 
-// Fonction pour détecter les cycles dans le graphe
-bool hasCycle(const Graph& g) {
-    bool cycle_detected = false;
-    CycleDetector vis(cycle_detected);
-    
-    // Vector pour marquer les sommets visités
-    std::vector<boost::default_color_type> colorMap(boost::num_vertices(g));
-    
-    // Recherche en profondeur pour détecter les cycles
-    boost::depth_first_search(g, boost::visitor(vis).color_map(boost::make_iterator_property_map(
-        colorMap.begin(), boost::get(boost::vertex_index, g))));
-    
-    return cycle_detected;
+// Sous-commande « snapshot » : convertit la paire de CSV en snapshot binaire
+// usage : graph_analysis snapshot nodes.csv edges.csv [graph.snap] [--threads=N] [--reorder=O]
+//         [--directed] [--weights=double|float] [--index-width=auto|32|64]
+template <class D>
+bool writeCsvSnapshot(const std::string& nodes_file, const std::string& edges_file, const std::string& snapshot_file,
+                      unsigned threads, VertexOrder order, const GraphLayout& layout) {
+    typedef typename boost::graph_traits<BasicGraph<D>>::directed_category Directed;
+    BasicGraph<D> g;
+    if (!loadCsvGraph(g, nodes_file, edges_file, threads)) return false;
+    reorderVertices(g, order);
+    bool ok = true;
+    withGraphConfigOf<Directed>(layout.flagsFor(boost::num_vertices(g), boost::num_edges(g)), [&](auto config) {
+        typedef decltype(config) Config;
+        auto t0 = std::chrono::high_resolution_clock::now();
+        BasicCsrGraph<Config> frozen(g);
+        g = BasicGraph<D>();
+        if (!saveSnapshot(frozen, snapshot_file)) {
+            std::cerr << "Erreur : Impossible d'écrire le snapshot " << snapshot_file << std::endl;
+            ok = false;
+            return;
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std::cout << "Snapshot " << snapshot_file << " : " << frozen.vertexCount() << " nœuds, "
+                  << frozen.edgeCount() << " arêtes (" << configName<Config>() << "), écrit en "
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+    });
+    return ok;
 }
 
-// Fonction pour calculer le chemin le plus court entre deux nœuds
-std::pair<double, std::vector<int>> shortestPath(const Graph& g, int startNodeId, int endNodeId) {
-    int start = startNodeId - 1;  // Convertir de l'ID à l'indice (le csv rang1 :/)
-    int end = endNodeId - 1;
-    
-    // Vérifier si les indices sont valides
-    if (start < 0 || start >= boost::num_vertices(g) || end < 0 || end >= boost::num_vertices(g)) {
-        std::cerr << "Erreur : Indices de nœuds invalides." << std::endl;
-        return {-1, {}};
-    }
-    
-    // sommet passé
-    std::vector<Vertex> predecessor(boost::num_vertices(g));
-    // distances passées
-    std::vector<double> distance(boost::num_vertices(g));
-    
-    // Exécuter l'algorithme de Dijkstra
-    // trouver sur internet/ à verifié
-    boost::dijkstra_shortest_paths(g, start, 
-        boost::predecessor_map(boost::make_iterator_property_map(predecessor.begin(), boost::get(boost::vertex_index, g)))
-        .distance_map(boost::make_iterator_property_map(distance.begin(), boost::get(boost::vertex_index, g)))
-        .weight_map(boost::get(&EdgeInfo::weight, g)));
-    
-    // Reconstruire le chemin
-    std::vector<int> path;
-    
-    // Vérifier si un chemin existe
-    if (predecessor[end] == end && start != end) {
-        return {-1, {}}; // Pas de chemin
+int runSnapshotCommand(int argc, char* argv[]) {
+    unsigned threads = 1;
+    VertexOrder order = VertexOrder::None;
+    GraphLayout layout;
+    std::vector<std::string> args;
+    for (int a = 2; a < argc; ++a) {
+        std::string arg = argv[a];
+        if (arg.compare(0, 10, "--threads=") == 0) {
+            if (!parseOptionNumber(arg, 10, threads)) return 1;
+        }
+        else if (arg.compare(0, 10, "--reorder=") == 0) {
+            if (!parseVertexOrder(arg.substr(10), order)) {
+                std::cerr << "Ordre des sommets inconnu : " << arg.substr(10) << " (none, rcm, morton)" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--directed") layout.directed = true;
+        else if (arg.compare(0, 10, "--weights=") == 0) {
+            if (!parseWeightType(arg.substr(10), layout.floatWeights)) {
+                std::cerr << "Type de poids inconnu : " << arg.substr(10) << " (double, float)" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg.compare(0, 14, "--index-width=") == 0) {
+            if (!parseIndexWidth(arg.substr(14), layout.index)) {
+                std::cerr << "Largeur d'indices inconnue : " << arg.substr(14) << " (auto, 32, 64)" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg.compare(0, 2, "--") == 0) {
+            std::cerr << "Option inconnue : " << arg << std::endl << kUsage << std::endl;
+            return 1;
+        }
+        else args.push_back(arg);
     }
-    
-    // Reconstruire le chemin à partir des prédécesseurs
-    for (Vertex v = end; ; v = predecessor[v]) {
-        path.push_back(g[v].id);
-        if (v == start) break;
+    if (args.size() < 2) {
+        std::cerr << "usage : graph_analysis snapshot nodes.csv edges.csv [graph.snap] [--threads=N] [--reorder=O]"
+                  << " [--directed] [--weights=double|float] [--index-width=auto|32|64]" << std::endl;
+        return 1;
     }
+    std::string snapshot_file = args.size() > 2 ? args[2] : args[1] + ".snap";
     
-    // Inverser le chemin pour qu'il soit du début à la fin
-    std::reverse(path.begin(), path.end());
-    
-    return {distance[end], path};
+    bool ok = layout.directed
+        ? writeCsvSnapshot<boost::directedS>(args[0], args[1], snapshot_file, threads, order, layout)
+        : writeCsvSnapshot<boost::undirectedS>(args[0], args[1], snapshot_file, threads, order, layout);
+    return ok ? 0 : 1;
 }
 
-// Fonction pour marquer les arêtes du chemin (pour l'illustration)
-void markPathEdges(Graph& g, const std::vector<int>& path) {
-    // Réinitialiser toutes les arêtes
-    boost::graph_traits<Graph>::edge_iterator ei, ei_end;
-    for (boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei) {
-        g[*ei].inPath = false;
+// --config=F : options lues dans un fichier, une par ligne (clé=valeur ou clé seule,
+// # pour les commentaires) ; elles sont placées avant celles de la ligne de commande
+bool loadConfigArgs(const std::string& filename, std::vector<std::string>& args) {
+    std::ifstream in(filename);
+    if (!in.is_open()) {
+        std::cerr << "Erreur : Impossible d'ouvrir le fichier de configuration " << filename << std::endl;
+        return false;
     }
-    
-    // Marquer les arêtes du chemin
-    for (size_t i = 0; i < path.size() - 1; ++i) {
-        int u = path[i] - 1;  // Convertir l'ID en indice
-        int v = path[i + 1] - 1;
-        
-        // Trouver l'arête entre u et v
-        Edge e;
-        bool exists;
-        boost::tie(e, exists) = boost::edge(u, v, g);
-        if (exists) {
-            g[e].inPath = true;
-        }
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) continue;
+        line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+        args.push_back(line.compare(0, 2, "--") == 0 ? line : "--" + line);
     }
+    return true;
 }
 
-// Fonction pour générer une illustration du graphe (sortie Graphviz DOT)
-void generateGraphImage(const Graph& g, const std::string& filename) {
-    std::ofstream dotFile(filename);
-    std::string pattern = ".png";
-    if (!dotFile.is_open()) {
-        std::cerr << "Erreur : Impossible de créer le fichier DOT." << std::endl;
-        return;
-    }
-    
-    // Écrire l'attribut pour le nœud (afficher l'ID)
-    auto vertex_writer = [&g](std::ostream& out, const Vertex& v) {
-        out << "[label=\"" << g[v].id << "\"]";
-    };
-    
-    // Écrire les attributs pour l'arête (couleur et poids)
-    auto edge_writer = [&g](std::ostream& out, const Edge& e) {
-        out << "[label=\"" << std::fixed << std::setprecision(2) << g[e].weight << "\"";
-        if (g[e].inPath) {
-            out << ", color=red, penwidth=2";
-        }
-        out << "]";
-    };
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "snapshot") return runSnapshotCommand(argc, argv);
     
-    // Écrire le graphe au format DOT
-    boost::write_graphviz(dotFile, g, vertex_writer, edge_writer);
-    if (!(filename.find(pattern) != std::string::npos)) { // test si l'utilisateur demande un PNG
-    std::cout << "Fichier DOT généré : " << filename << std::endl;
-    std::cout << "Pour visualiser le graphe, utilisez Graphviz avec la commande :" << std::endl;
-    std::cout << "dot -Tpng " << filename << " -o graph.png" << std::endl;
-    } else {
-    // Command to generate a PNG from a DOT file
-    std::string command = "dot -Tpng " + filename + " -o " + filename;
-    int result = system(command.c_str());
-
-    // Check the result for success or failure
-    if (result == 0) {
-        std::cout << "png successfully!" << std::endl;
-    } else {
-        std::cerr << "Error making png!" << std::endl;
+    // --config d'abord : la ligne de commande l'emporte sur le fichier
+    std::vector<std::string> argList;
+    for (int a = 1; a < argc; ++a) {
+        std::string arg = argv[a];
+        if (arg.compare(0, 9, "--config=") == 0 && !loadConfigArgs(arg.substr(9), argList)) return 1;
     }
-    std::cout << "PNG réalsier" << std::endl;
-    }
-}
-
-// Fonction pour écrire les résultats des chemins les plus courts dans un fichier CSV
-void writePathsToCSV(const Graph& g, const std::vector<std::pair<int, int>>& nodePairs, const std::string& filename) {
-    std::ofstream csvFile(filename);
-    if (!csvFile.is_open()) {
-        std::cerr << "Erreur : Impossible de créer le fichier CSV." << std::endl;
-        return;
+    for (int a = 1; a < argc; ++a) {
+        if (std::string(argv[a]).compare(0, 9, "--config=") != 0) argList.push_back(argv[a]);
     }
     
-    // Écrire l'en-tête du CSV
-    csvFile << "SourceNodeID;TargetNodeID;PathLength;Path" << std::endl;
-    
-    // Pour chaque paire de nœuds
-    for (const auto& pair : nodePairs) {
-        int source = pair.first;
-        int target = pair.second;
-        
-        // Calculer le chemin le plus court
-        auto result = shortestPath(g, source, target);
-        double distance = result.first;
-        const auto& path = result.second;
-        
-        // Écrire dans le CSV
-        csvFile << source << ";" << target << ";" << std::fixed << std::setprecision(2) << distance << ";";
-        
-        // Écrire le chemin
-        if (path.empty()) {
-            csvFile << "No path";
-        } else {
-            for (size_t i = 0; i < path.size(); ++i) {
-                csvFile << path[i];
-                if (i < path.size() - 1) {
-                    csvFile << "->";
-                }
+    // Séparer les options (--threads=N, --query-threads=N, --path-mode=M, --csr, --coords=F,
+    // --build-index[=F], --index[=F], --index-kind=K, --landmarks=N, --snapshot=F, --verify-snapshot,
+    // --report=F, --insert=F, --delete=F, --batch, --start=N, --end=N, --start-pos=P, --end-pos=P,
+    // --nodes=F, --edges=F, --paths=F, --graph=F, --serve[=SOCKET], --config=F, --metrics=F, --metrics-format=K,
+    // --metrics-interval=S, --render=V, --render-pos, --render-hops=K, --render-max-nodes=N, --reorder=O,
+    // --directed, --weights=T, --index-width=W, --centrality[=K], --centrality-seed=S)
+    // des arguments positionnels
+    RunOptions opt;  // output_csv : ça on ne demande pas
+    bool use_csr = false;
+    GraphLayout layout;  // --directed, --weights, --index-width : configuration du graphe
+    VertexOrder order = VertexOrder::None;
+    std::string snapshot_file;
+    bool verify_snapshot = false;
+    bool use_index = false;
+    std::string nodes_option, edges_option, paths_option, graph_option;
+    std::string metrics_file;
+    MetricsFormat metrics_format = MetricsFormat::Json;
+    bool metrics_format_set = false;
+    double metrics_interval = 0.0;
+    bool batch = false;
+    std::vector<std::string> args;
+    for (const std::string& arg : argList) {
+        if (arg.compare(0, 10, "--threads=") == 0) {
+            if (!parseOptionNumber(arg, 10, opt.threads)) return 1;
+        } else if (arg.compare(0, 16, "--query-threads=") == 0) {
+            if (!parseOptionNumber(arg, 16, opt.query_threads)) return 1;
+        } else if (arg.compare(0, 12, "--path-mode=") == 0) {
+            if (!parsePathMode(arg.substr(12), opt.path_mode)) {
+                std::cerr << "Mode de chemin inconnu : " << arg.substr(12) << " (dijkstra, astar, bidir, delta)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--csr") {
+            use_csr = true;
+        } else if (arg.compare(0, 10, "--reorder=") == 0) {
+            if (!parseVertexOrder(arg.substr(10), order)) {
+                std::cerr << "Ordre des sommets inconnu : " << arg.substr(10) << " (none, rcm, morton)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--directed") {
+            layout.directed = true;
+        } else if (arg.compare(0, 10, "--weights=") == 0) {
+            if (!parseWeightType(arg.substr(10), layout.floatWeights)) {
+                std::cerr << "Type de poids inconnu : " << arg.substr(10) << " (double, float)" << std::endl;
+                return 1;
+            }
+        } else if (arg.compare(0, 14, "--index-width=") == 0) {
+            if (!parseIndexWidth(arg.substr(14), layout.index)) {
+                std::cerr << "Largeur d'indices inconnue : " << arg.substr(14) << " (auto, 32, 64)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--centrality" || arg.compare(0, 13, "--centrality=") == 0) {
+            opt.centrality.enabled = true;
+            if (arg.size() > 13 && !parseOptionNumber(arg, 13, opt.centrality.samples)) return 1;
+        } else if (arg.compare(0, 18, "--centrality-seed=") == 0) {
+            if (!parseOptionNumber(arg, 18, opt.centrality.seed)) return 1;
+        } else if (arg.compare(0, 9, "--coords=") == 0) {
+            opt.coords_file = arg.substr(9);
+        } else if (arg == "--build-index" || arg.compare(0, 14, "--build-index=") == 0) {
+            opt.build_index = use_index = true;
+            if (arg.size() > 14) opt.index_file = arg.substr(14);
+        } else if (arg == "--index" || arg.compare(0, 8, "--index=") == 0) {
+            use_index = true;
+            if (arg.size() > 8) opt.index_file = arg.substr(8);
+        } else if (arg.compare(0, 13, "--index-kind=") == 0) {
+            std::string kind = arg.substr(13);
+            if (kind == "apsp") opt.index_kind = DistanceIndex::AllPairs;
+            else if (kind == "alt") opt.index_kind = DistanceIndex::Landmarks;
+            else {
+                std::cerr << "Type d'index inconnu : " << kind << " (apsp ou alt)" << std::endl;
+                return 1;
+            }
+        } else if (arg.compare(0, 12, "--landmarks=") == 0) {
+            if (!parseOptionNumber(arg, 12, opt.landmarks)) return 1;
+        } else if (arg.compare(0, 11, "--snapshot=") == 0) {
+            snapshot_file = arg.substr(11);
+        } else if (arg == "--verify-snapshot") {
+            verify_snapshot = true;
+        } else if (arg.compare(0, 9, "--report=") == 0) {
+            opt.report_file = arg.substr(9);
+        } else if (arg.compare(0, 9, "--insert=") == 0) {
+            opt.deltas.push_back(std::make_pair(true, arg.substr(9)));
+        } else if (arg.compare(0, 9, "--delete=") == 0) {
+            opt.deltas.push_back(std::make_pair(false, arg.substr(9)));
+        } else if (arg == "--batch") {
+            batch = true;
+        } else if (arg.compare(0, 8, "--start=") == 0) {
+            if (!parseOptionNumber(arg, 8, opt.start_node)) return 1;
+        } else if (arg.compare(0, 6, "--end=") == 0) {
+            if (!parseOptionNumber(arg, 6, opt.end_node)) return 1;
+        } else if (arg.compare(0, 12, "--start-pos=") == 0 || arg.compare(0, 10, "--end-pos=") == 0) {
+            bool start = arg.compare(0, 12, "--start-pos=") == 0;
+            std::string value = arg.substr(start ? 12 : 10);
+            if (!parsePoint3(value, start ? opt.start_pos : opt.end_pos)) {
+                std::cerr << "Position invalide : " << value << " (x,y,z)" << std::endl;
+                return 1;
+            }
+            (start ? opt.has_start_pos : opt.has_end_pos) = true;
+        } else if (arg.compare(0, 8, "--nodes=") == 0) {
+            nodes_option = arg.substr(8);
+        } else if (arg.compare(0, 8, "--edges=") == 0) {
+            edges_option = arg.substr(8);
+        } else if (arg.compare(0, 8, "--paths=") == 0) {
+            paths_option = arg.substr(8);
+        } else if (arg.compare(0, 8, "--graph=") == 0) {
+            graph_option = arg.substr(8);
+        } else if (arg.compare(0, 9, "--render=") == 0) {
+            if (!parseRenderView(arg.substr(9), opt.render.view)) {
+                std::cerr << "Vue inconnue : " << arg.substr(9) << " (auto, full, route, sample, components)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--render-pos") {
+            opt.render.positions = true;
+        } else if (arg.compare(0, 14, "--render-hops=") == 0) {
+            if (!parseOptionNumber(arg, 14, opt.render.hops)) return 1;
+        } else if (arg.compare(0, 19, "--render-max-nodes=") == 0) {
+            if (!parseOptionNumber(arg, 19, opt.render.maxNodes)) return 1;
+            opt.render.maxNodes = std::max<size_t>(1, opt.render.maxNodes);
+        } else if (arg.compare(0, 10, "--metrics=") == 0) {
+            metrics_file = arg.substr(10);
+        } else if (arg.compare(0, 17, "--metrics-format=") == 0) {
+            std::string format = arg.substr(17);
+            metrics_format_set = true;
+            if (format == "json") metrics_format = MetricsFormat::Json;
+            else if (format == "prometheus") metrics_format = MetricsFormat::Prometheus;
+            else {
+                std::cerr << "Format de mesures inconnu : " << format << " (json ou prometheus)" << std::endl;
+                return 1;
             }
+        } else if (arg.compare(0, 19, "--metrics-interval=") == 0) {
+            if (!parseOptionNumber(arg, 19, metrics_interval)) return 1;
+        } else if (arg == "--serve" || arg.compare(0, 8, "--serve=") == 0) {
+            opt.serve = true;
+            if (arg.size() > 8) opt.serve_socket = arg.substr(8);
+        } else if (arg.compare(0, 2, "--") == 0) {
+            std::cerr << "Option inconnue : " << arg << std::endl << kUsage << std::endl;
+            return 1;
+        } else {
+            args.push_back(arg);
         }
-        csvFile << std::endl;
     }
     
-    std::cout << "Fichier CSV généré : " << filename << std::endl;
-}
-
-// Fonction principale pour générer le rapport d'analyse du graphe
-void generateGraphReport(Graph& g, int start, int end) {
-    std::cout << "=== RAPPORT D'ANALYSE DU GRAPHE ===" << std::endl;
-    std::cout << "Nombre de nœuds: " << boost::num_vertices(g) << std::endl;
-    std::cout << "Nombre d'arêtes: " << boost::num_edges(g) << std::endl;
+    // questions sur stdin seulement pour un lancement à la main sans fichier : --batch, --serve,
+    // un fichier donné (argument ou --nodes, --edges, --paths, --graph, --snapshot) ou une
+    // entrée qui n'est pas un terminal les suppriment
+    bool files_given = !args.empty() || !nodes_option.empty() || !edges_option.empty() || !paths_option.empty()
+        || !graph_option.empty() || !snapshot_file.empty();
+    opt.interactive = !batch && !opt.serve && !files_given && isatty(0);
     
-    // i. Calculer et afficher le degré de chaque nœud
-    std::cout << "\n== i. Degré des nœuds ==" << std::endl;
+    // poids float ou indices 32 bits : seul le CSR figé les stocke
+    if (layout.floatWeights || layout.index == IndexWidth::Narrow) use_csr = true;
     
-    int max_degree = 0;
-    boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
-    for (boost::tie(vi, vi_end) = boost::vertices(g); vi != vi_end; ++vi) {
-        int degree = boost::degree(*vi, g);
-        std::cout << "Nœud " << g[*vi].id << ": " << degree << std::endl;
-        
-        if (degree > max_degree) {
-            max_degree = degree;
-        }
+    // le CSR est figé : les mises à jour passent par l'adjacency_list
+    if (!opt.deltas.empty() && (use_csr || !snapshot_file.empty())) {
+        std::cerr << "Erreur : --insert / --delete demandent le graphe modifiable (sans --csr ni --snapshot, "
+                  << "--weights=float ou --index-width=32)" << std::endl;
+        return 1;
+    }
+    if (!opt.deltas.empty() && layout.directed) {
+        std::cerr << "Erreur : --insert / --delete ne sont pas disponibles avec --directed" << std::endl;
+        return 1;
     }
     
-    // Calculer et afficher le degré du graphe (degré maximum)
-    std::cout << "Degré du graphe: " << max_degree << std::endl;
-    
-    // Vérifiation la connectivité du graphe
-    std::cout << "\n== ii. Connectivité du graphe ==" << std::endl;
-    bool connected = isConnected(g);
-    std::cout << "Le graphe est " << (connected ? "connecté" : "non connecté") << std::endl;
-    
-    // Détection de cycles
-    std::cout << "\n== iii. Détection de cycles ==" << std::endl;
-    bool cycle = hasCycle(g);
-    std::cout << "Le graphe " << (cycle ? "contient":"ne contient pas") << " de cycle" << std::endl;
-    std::cout << "Explication de l'algorithme de détection de cycles:" << std::endl;
-    std::cout << "1. Utilisation d'un parcours en profondeur (DFS) du graphe" << std::endl;
-    std::cout << "2. Lors du parcours, nous maintenons un état pour chaque nœud (non visité, en cours, visité)" << std::endl;
-    std::cout << "3. Quand nous rencontrons une arête arrière (qui mène à un nœud en cours de visite), un cycle est détecté" << std::endl;
-    std::cout << "4. L'implémentation utilise le visiteur boost::dfs_visitor qui détecte les arêtes arrière" << std::endl;
-    
-    // iv. Exemple de calcul de chemin le plus court
-    std::cout << "\n== iv. calcul de chemin le plus court ==" << std::endl;
-    std::cout <<"    * node de départ: "<< start <<std::endl;
-    std::cout <<"    * node d'arrivé: "<< end <<std::endl;
-    //int start = 1;  // ID du nœud de départ
-    //int end = 20;   // ID du nœud d'arrivée
-    
-    auto pathResult = shortestPath(g, start, end);
-    double pathLength = pathResult.first;
-    const auto& path = pathResult.second;
-    
-    std::cout << "Chemin le plus court de " << start << " à " << end << ": ";
-    if (pathLength < 0) {
-        std::cout << "Pas de chemin trouvé" << std::endl;
-    } else {
-        std::cout << "Longueur = " << std::fixed << std::setprecision(2) << pathLength << std::endl;
-        std::cout << "Chemin: ";
-        for (size_t i = 0; i < path.size(); ++i) {
-            std::cout << path[i];
-            if (i < path.size() - 1) {
-                std::cout << " -> ";
-            }
-        }
-        std::cout << std::endl;
-        
-        // Marquer les arêtes du chemin pour l'illustration
-        markPathEdges(g, path);
+    if (opt.serve && !opt.deltas.empty()) {
+        std::cerr << "Erreur : --insert / --delete ne sont pas disponibles en mode --serve" << std::endl;
+        return 1;
     }
-}
-
-int main(int argc, char* argv[]) {
+    // serveur sur stdin / stdout : stdout ne porte que les réponses, les messages passent sur stderr
+    if (opt.serve && opt.serve_socket.empty()) std::cout.rdbuf(std::cerr.rdbuf());
+    
     // Chemins par défaut des fichiers
     std::string nodes_file = "nodes.csv";
-    std::cout << "Veuillez entrer le nom du fichier nodes : "<<std::endl;
-    std::cout << "(ex: nodes.csv)"<<std::endl;
-    std::getline(std::cin, nodes_file);
     std::string edges_file = "edges.csv";
-    std::cout << "Veuillez entrer le nom du fichier edge : "<<std::endl;
-    std::cout << "(ex: edges.csv)"<<std::endl;
-    std::getline(std::cin, edges_file);
-    std::string output_csv = "paths.csv";// ça on ne demande pas
-    std::string output_dot = "graph.png";
-    std::cout << "Veuillez entrer le nom du fichier graph : "<<std::endl;
-    std::cout << "(ex: graph.dot ou graph.png)"<<std::endl;
-    std::getline(std::cin, output_dot);
+    if (opt.interactive) {
+        std::cout << "Veuillez entrer le nom du fichier nodes : "<<std::endl;
+        std::cout << "(ex: nodes.csv)"<<std::endl;
+        std::getline(std::cin, nodes_file);
+        std::cout << "Veuillez entrer le nom du fichier edge : "<<std::endl;
+        std::cout << "(ex: edges.csv)"<<std::endl;
+        std::getline(std::cin, edges_file);
+        std::cout << "Veuillez entrer le nom du fichier graph : "<<std::endl;
+        std::cout << "(ex: graph.dot ou graph.png)"<<std::endl;
+        std::getline(std::cin, opt.output_dot);
+    }
     
-    // Utiliser les arguments de ligne de commande si fournis
-    if (argc > 1) nodes_file = argv[1];
-    if (argc > 2) edges_file = argv[2];
-    if (argc > 3) output_csv = argv[3];
-    if (argc > 4) output_dot = argv[4];
+    // Utiliser les arguments de ligne de commande si fournis (options nommées, puis positionnels)
+    if (!nodes_option.empty()) nodes_file = nodes_option;
+    if (!edges_option.empty()) edges_file = edges_option;
+    if (!paths_option.empty()) opt.output_csv = paths_option;
+    if (!graph_option.empty()) opt.output_dot = graph_option;
+    if (args.size() > 0) nodes_file = args[0];
+    if (args.size() > 1) edges_file = args[1];
+    if (args.size() > 2) opt.output_csv = args[2];
+    if (args.size() > 3) opt.output_dot = args[3];
+    // l'index est rangé à côté du graphe par défaut
+    if (use_index && opt.index_file.empty()) {
+        opt.index_file = (snapshot_file.empty() ? edges_file : snapshot_file) + ".idx";
+    }
+    
+    // --metrics : mesures activées, exportées à la fin (et toutes les S secondes avec --metrics-interval)
+    std::unique_ptr<MetricsReporter> reporter;
+    if (!metrics_file.empty()) {
+        Metrics::enable();
+        if (!metrics_format_set) metrics_format = metricsFormatFor(metrics_file);
+        reporter.reset(new MetricsReporter(metrics_file, metrics_format, metrics_interval));
+    }
     
     // Afficher les informations sur la version de Boost
     std::cout << "Utilisation de Boost version " 
@@ -411,55 +460,31 @@ int main(int argc, char* argv[]) {
     // Démarrer le chronomètre
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    // Charger les nœuds
-    std::vector<NodeInfo> nodes = loadNodes(nodes_file);
-    
-    if (nodes.empty()) {
-        std::cerr << "Erreur : Aucun nœud chargé." << std::endl;
-        return 1;
-    }
-    
-    // Créer le graphe avec le bon nombre de nœuds
-    Graph g(nodes.size());
-    
-    // Associer les informations de nœuds au graphe
-    boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
-    int i = 0;
-    for (boost::tie(vi, vi_end) = boost::vertices(g); vi != vi_end; ++vi, ++i) {
-        g[*vi] = nodes[i];
+    // --snapshot : graphe CSR projeté directement depuis le fichier binaire, sans CSV
+    if (!snapshot_file.empty()) {
+        std::uint64_t config = 0;
+        if (!snapshotConfig(snapshot_file, config)) return 1;
+        bool ok = true;
+        withGraphConfig(config, [&](auto c) {
+            ok = analyzeSnapshot<decltype(c)>(snapshot_file, verify_snapshot, opt);
+        });
+        if (!ok) return 1;
+    } else if (layout.directed) {
+        if (opt.path_mode == PathMode::Bidirectional) {
+            std::cout << "Graphe orienté : recherche bidirectionnelle indisponible, Dijkstra utilisé" << std::endl;
+        }
+        if (!analyzeCsvGraph<boost::directedS>(nodes_file, edges_file, order, use_csr, layout, opt)) return 1;
+    } else if (opt.deltas.empty()) {
+        if (!analyzeCsvGraph<boost::undirectedS>(nodes_file, edges_file, order, use_csr, layout, opt)) return 1;
+    } else {
+        // --insert / --delete : l'adjacency_list reste disponible après l'analyse
+        Graph g;
+        if (!loadCsvGraph(g, nodes_file, edges_file, opt.threads)) return 1;
+        reorderVertices(g, order);
+        runAnalysis(g, opt);
+        applyDeltas(g, opt);
     }
     
-    // Charger les arêtes
-    loadEdges(g, edges_file);
-    
-    int node1, node2; // Variables to store the user's input
-
-    // Prompt the user for the first number
-    std::cout << "Selection de 2 nodes pour un calcul de chemin" << std::endl;
-    std::cout << "Entrer la node de départ: ";
-    std::cin >> node1;
-
-    // Prompt the user for the second number
-    std::cout << "Entrer la node d'arrivé': ";
-    std::cin >> node2;
-
-    // Générer le rapport d'analyse
-    generateGraphReport(g, node1, node2);
-    
-    // v. Générer une illustration du graphe
-    generateGraphImage(g, output_dot);
-    
-    // vi. Écrire les chemins dans un fichier CSV
-    // Liste de paires de nœuds pour le calcul des chemins
-    std::vector<std::pair<int, int>> nodePairs = {
-        {1, 5}, {1, 10}, {1, 15}, {1, 20},
-        {5, 10}, {5, 15}, {5, 20},
-        {10, 15}, {10, 20},
-        {15, 20}
-    };
-    
-    writePathsToCSV(g, nodePairs, output_csv);
-    
     // vii. Afficher le temps de calcul
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -468,4 +493,4 @@ int main(int argc, char* argv[]) {
     std::cout << "Temps total d'exécution: " << duration.count() << " ms" << std::endl;
     
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,209 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+// Mesures par étape : temps cumulé et nombre d'appels de chaque phase (ScopedPhase),
+// compteurs (lignes lues, arêtes rejetées, sommets fixés par Dijkstra, octets écrits...)
+// et pic de mémoire résidente, exportés en JSON ou au format texte de Prometheus.
+// Désactivées par défaut : chaque point de mesure se réduit alors à la lecture d'un
+// booléen ; les boucles chaudes (Dijkstra, parsing) comptent dans des variables locales
+// et ne publient qu'une fois par appel.
+// MetricsReporter réécrit le fichier périodiquement (mode serveur).
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <sys/resource.h>
+
+enum class Phase : unsigned {
+    ParseNodes, ParseEdges, BuildGraph, FreezeCsr, LoadSnapshot, Analysis,
+    ShortestPaths, WriteDot, RenderImage, WriteCsv, ServeBatch, SpatialIndex, Reorder, Centrality, Count
+};
+
+enum class Counter : unsigned {
+    RowsParsed, EdgesRejected, EdgesInserted, PathQueries, VerticesSettled,
+    HeapPushes, HeapPops, BytesWritten, Requests, Count
+};
+
+enum class MetricsFormat { Json, Prometheus };
+
+inline const char* phaseName(Phase phase) {
+    static const char* const names[] = {
+        "parse_nodes", "parse_edges", "build_graph", "freeze_csr", "load_snapshot", "analysis",
+        "shortest_paths", "write_dot", "render_image", "write_csv", "serve_batch", "spatial_index", "reorder", "centrality"
+    };
+    return names[static_cast<unsigned>(phase)];
+}
+
+inline const char* counterName(Counter counter) {
+    static const char* const names[] = {
+        "rows_parsed", "edges_rejected", "edges_inserted", "path_queries", "vertices_settled",
+        "heap_pushes", "heap_pops", "bytes_written", "requests"
+    };
+    return names[static_cast<unsigned>(counter)];
+}
+
+// Format déduit du nom de fichier : .prom => Prometheus, sinon JSON
+inline MetricsFormat metricsFormatFor(const std::string& filename) {
+    const std::string ext = ".prom";
+    bool prom = filename.size() >= ext.size() && filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+    return prom ? MetricsFormat::Prometheus : MetricsFormat::Json;
+}
+
+class Metrics {
+public:
+    static constexpr unsigned kPhases = static_cast<unsigned>(Phase::Count);
+    static constexpr unsigned kCounters = static_cast<unsigned>(Counter::Count);
+
+    static void enable(bool on = true) { _enabled.store(on, std::memory_order_relaxed); }
+    static bool enabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    static void add(Counter counter, std::uint64_t n = 1) {
+        if (enabled()) _counters[static_cast<unsigned>(counter)].fetch_add(n, std::memory_order_relaxed);
+    }
+    static void addTime(Phase phase, std::uint64_t nanoseconds) {
+        unsigned p = static_cast<unsigned>(phase);
+        _phaseCalls[p].fetch_add(1, std::memory_order_relaxed);
+        _phaseNanos[p].fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    static std::uint64_t count(Counter counter) {
+        return _counters[static_cast<unsigned>(counter)].load(std::memory_order_relaxed);
+    }
+    static std::uint64_t calls(Phase phase) {
+        return _phaseCalls[static_cast<unsigned>(phase)].load(std::memory_order_relaxed);
+    }
+    static double seconds(Phase phase) {
+        return _phaseNanos[static_cast<unsigned>(phase)].load(std::memory_order_relaxed) * 1e-9;
+    }
+
+    // Pic de mémoire résidente du processus (ru_maxrss est en Ko sous Linux)
+    static std::uint64_t peakRssBytes() {
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+        return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+    }
+
+    static void writeJson(std::ostream& out) {
+        out << "{\n  \"phases\": {";
+        for (unsigned p = 0; p < kPhases; ++p) {
+            Phase phase = static_cast<Phase>(p);
+            out << (p ? ",\n" : "\n") << "    \"" << phaseName(phase) << "\": {\"calls\": " << calls(phase)
+                << ", \"seconds\": " << std::fixed << std::setprecision(6) << seconds(phase) << "}";
+        }
+        out << "\n  },\n  \"counters\": {";
+        for (unsigned c = 0; c < kCounters; ++c) {
+            Counter counter = static_cast<Counter>(c);
+            out << (c ? ",\n" : "\n") << "    \"" << counterName(counter) << "\": " << count(counter);
+        }
+        out << "\n  },\n  \"peak_rss_bytes\": " << peakRssBytes() << "\n}\n";
+    }
+
+    static void writePrometheus(std::ostream& out) {
+        out << "# HELP graphcpp_phase_seconds_total Temps cumulé par phase.\n"
+               "# TYPE graphcpp_phase_seconds_total counter\n";
+        for (unsigned p = 0; p < kPhases; ++p) {
+            Phase phase = static_cast<Phase>(p);
+            out << "graphcpp_phase_seconds_total{phase=\"" << phaseName(phase) << "\"} "
+                << std::fixed << std::setprecision(6) << seconds(phase) << "\n";
+        }
+        out << "# HELP graphcpp_phase_calls_total Nombre d'exécutions par phase.\n"
+               "# TYPE graphcpp_phase_calls_total counter\n";
+        for (unsigned p = 0; p < kPhases; ++p) {
+            Phase phase = static_cast<Phase>(p);
+            out << "graphcpp_phase_calls_total{phase=\"" << phaseName(phase) << "\"} " << calls(phase) << "\n";
+        }
+        for (unsigned c = 0; c < kCounters; ++c) {
+            Counter counter = static_cast<Counter>(c);
+            out << "# TYPE graphcpp_" << counterName(counter) << "_total counter\n"
+                << "graphcpp_" << counterName(counter) << "_total " << count(counter) << "\n";
+        }
+        out << "# HELP graphcpp_peak_rss_bytes Pic de mémoire résidente.\n"
+               "# TYPE graphcpp_peak_rss_bytes gauge\n"
+               "graphcpp_peak_rss_bytes " << peakRssBytes() << "\n";
+    }
+
+    // Écrit dans un fichier temporaire puis le renomme : un lecteur ne voit jamais un export à moitié écrit
+    static bool writeFile(const std::string& filename, MetricsFormat format) {
+        std::string tmp = filename + ".tmp";
+        {
+            std::ofstream out(tmp);
+            if (!out.is_open()) return false;
+            if (format == MetricsFormat::Prometheus) writePrometheus(out);
+            else writeJson(out);
+            if (!out) return false;
+        }
+        return std::rename(tmp.c_str(), filename.c_str()) == 0;
+    }
+
+private:
+    inline static std::atomic<bool> _enabled{false};
+    inline static std::atomic<std::uint64_t> _counters[kCounters] = {};
+    inline static std::atomic<std::uint64_t> _phaseCalls[kPhases] = {};
+    inline static std::atomic<std::uint64_t> _phaseNanos[kPhases] = {};
+};
+
+// Chronomètre une phase jusqu'à la fin du bloc (rien si les mesures sont désactivées)
+class ScopedPhase {
+public:
+    explicit ScopedPhase(Phase phase) : _phase(phase), _active(Metrics::enabled()) {
+        if (_active) _t0 = std::chrono::steady_clock::now();
+    }
+    ~ScopedPhase() {
+        if (!_active) return;
+        auto elapsed = std::chrono::steady_clock::now() - _t0;
+        Metrics::addTime(_phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+    Phase _phase;
+    bool _active;
+    std::chrono::steady_clock::time_point _t0;
+};
+
+// Export périodique dans un thread à part, plus un dernier export à la destruction
+class MetricsReporter {
+public:
+    MetricsReporter(const std::string& filename, MetricsFormat format, double intervalSeconds)
+        : _filename(filename), _format(format) {
+        if (intervalSeconds <= 0) return;
+        auto interval = std::chrono::duration<double>(intervalSeconds);
+        _thread = std::thread([this, interval]() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_stop.wait_for(lock, interval, [this]() { return _stopping; })) {
+                Metrics::writeFile(_filename, _format);
+            }
+        });
+    }
+    ~MetricsReporter() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _stop.notify_all();
+        if (_thread.joinable()) _thread.join();
+        Metrics::writeFile(_filename, _format);
+    }
+    MetricsReporter(const MetricsReporter&) = delete;
+    MetricsReporter& operator=(const MetricsReporter&) = delete;
+
+private:
+    std::string _filename;
+    MetricsFormat _format;
+    std::mutex _mutex;
+    std::condition_variable _stop;
+    bool _stopping = false;
+    std::thread _thread;
+};
+
+#endif
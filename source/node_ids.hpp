@@ -0,0 +1,131 @@
+#ifndef NODE_IDS_HPP
+#define NODE_IDS_HPP
+
+// Correspondance entre les IDs du CSV (entiers 64 bits quelconques, pas forcément
+// consécutifs ni triés) et les indices 0..n-1 des sommets, construite une fois après
+// loadNodes. Représentation choisie selon les IDs :
+// - décalage : IDs consécutifs dans l'ordre des lignes (id = base + indice), le cas des
+//   fichiers numérotés 1..n : aucune table, une soustraction par recherche
+// - table directe : IDs peu dispersés (max - min < 2n), un tableau indexé par id - min
+// - hachage : IDs clairsemés, adressage ouvert à sondage linéaire sur des cases
+//   {id, indice} de 16 octets, capacité puissance de 2 >= 2n, mélange splitmix64
+// Un ID présent sur plusieurs lignes désigne la première (les suivantes restent des
+// sommets du graphe mais ne sont plus joignables par leur ID).
+// Une correspondance construite par défaut est le décalage de base 1 (IDs = indice + 1).
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+typedef std::int64_t NodeId;
+
+class NodeIdMap {
+public:
+    enum Kind { Offset, Table, Hash };
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    NodeIdMap() {}
+
+    // idAt(v) = ID du sommet v, pour v dans [0, n)
+    template <class IdAt>
+    NodeIdMap(std::size_t n, IdAt idAt) {
+        if (n == 0) return;
+        NodeId low = idAt(0), high = low;
+        bool consecutive = true;
+        for (std::size_t v = 1; v < n; ++v) {
+            NodeId id = idAt(v);
+            consecutive = consecutive && id == idAt(0) + static_cast<NodeId>(v);
+            if (id < low) low = id;
+            if (id > high) high = id;
+        }
+        _base = low;
+        if (consecutive) return;
+
+        const std::uint64_t span = static_cast<std::uint64_t>(high) - static_cast<std::uint64_t>(low);
+        if (span < 2 * static_cast<std::uint64_t>(n)) {
+            _kind = Table;
+            _table.assign(span + 1, kEmpty);
+            for (std::size_t v = 0; v < n; ++v) {
+                std::uint32_t& slot = _table[static_cast<std::uint64_t>(idAt(v)) - static_cast<std::uint64_t>(low)];
+                if (slot == kEmpty) slot = static_cast<std::uint32_t>(v);
+                else ++_duplicates;
+            }
+            return;
+        }
+
+        _kind = Hash;
+        std::size_t capacity = 16;
+        while (capacity < 2 * n) capacity *= 2;
+        _mask = capacity - 1;
+        _slots.assign(capacity, Slot{ 0, kEmpty });
+        for (std::size_t v = 0; v < n; ++v) {
+            NodeId id = idAt(v);
+            std::size_t h = hash(id) & _mask;
+            while (_slots[h].vertex != kEmpty && _slots[h].id != id) h = (h + 1) & _mask;
+            if (_slots[h].vertex == kEmpty) _slots[h] = Slot{ id, static_cast<std::uint32_t>(v) };
+            else ++_duplicates;
+        }
+    }
+
+    // Indice du sommet d'ID id dans un graphe de n sommets, npos si l'ID est inconnu
+    std::size_t vertex(NodeId id, std::size_t n) const {
+        switch (_kind) {
+        case Offset: {
+            std::uint64_t v = static_cast<std::uint64_t>(id) - static_cast<std::uint64_t>(_base);
+            return id >= _base && v < n ? static_cast<std::size_t>(v) : npos;
+        }
+        case Table: {
+            std::uint64_t k = static_cast<std::uint64_t>(id) - static_cast<std::uint64_t>(_base);
+            if (id < _base || k >= _table.size() || _table[k] == kEmpty) return npos;
+            return _table[k];
+        }
+        default: {
+            std::size_t h = hash(id) & _mask;
+            while (_slots[h].vertex != kEmpty) {
+                if (_slots[h].id == id) return _slots[h].vertex;
+                h = (h + 1) & _mask;
+            }
+            return npos;
+        }
+        }
+    }
+
+    Kind kind() const { return _kind; }
+    std::size_t duplicates() const { return _duplicates; }
+
+    const char* kindName() const {
+        switch (_kind) {
+        case Table: return "table directe";
+        case Hash: return "hachage";
+        default: return "décalage";
+        }
+    }
+
+private:
+    static constexpr std::uint32_t kEmpty = std::numeric_limits<std::uint32_t>::max();
+
+    struct Slot {
+        NodeId id;
+        std::uint32_t vertex;  // kEmpty : case libre
+    };
+
+    // Finaliseur de splitmix64 : des IDs en progression régulière (multiples d'un pas,
+    // préfixes par site...) se répartissent uniformément sur les cases
+    static std::uint64_t hash(NodeId id) {
+        std::uint64_t x = static_cast<std::uint64_t>(id);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    Kind _kind = Offset;
+    NodeId _base = 1;                   // décalage : ID du sommet 0 ; table : plus petit ID
+    std::vector<std::uint32_t> _table;  // table directe : sommet de l'ID _base + k
+    std::vector<Slot> _slots;           // hachage
+    std::size_t _mask = 0;
+    std::size_t _duplicates = 0;
+};
+
+#endif
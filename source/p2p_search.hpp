@@ -0,0 +1,239 @@
+#ifndef P2P_SEARCH_HPP
+#define P2P_SEARCH_HPP
+
+// Recherches point à point avec arrêt dès que la cible est fixée
+// - A* (boost::astar_search) : les poids étant la distance euclidienne entre les
+//   coordonnées des nœuds, la distance à vol d'oiseau jusqu'à la cible est une
+//   heuristique admissible et consistante
+// - Dijkstra bidirectionnel : une recherche depuis la source, une depuis la cible
+//   (graphe non orienté : mêmes out_edges), arrêt quand les deux fronts se croisent ;
+//   un graphe orienté n'a pas les arcs entrants, PathQueryEngine passe alors par Dijkstra
+// La longueur renvoyée est resommée le long du chemin dans le sens source -> cible,
+// comme le fait Dijkstra, pour donner exactement la même valeur que le mode par défaut.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/graph/astar_search.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include "graph_types.hpp"
+
+// DeltaStepping : un Dijkstra parallèle par source (delta_stepping.hpp), pour les très grands graphes
+enum class PathMode { Dijkstra, AStar, Bidirectional, DeltaStepping };
+
+inline bool parsePathMode(const std::string& name, PathMode& mode) {
+    if (name == "dijkstra") mode = PathMode::Dijkstra;
+    else if (name == "astar") mode = PathMode::AStar;
+    else if (name == "bidir") mode = PathMode::Bidirectional;
+    else if (name == "delta") mode = PathMode::DeltaStepping;
+    else return false;
+    return true;
+}
+
+// Longueur d'un chemin (indices de sommets) sommée de la source vers la cible
+template <class G>
+double pathLength(const G& g, const std::vector<typename boost::graph_traits<G>::vertex_descriptor>& vertices) {
+    auto weights = get(&EdgeInfo::weight, g);
+    double length = 0.0;
+    for (std::size_t i = 0; i + 1 < vertices.size(); ++i) {
+        // arête la plus légère entre les deux sommets (il peut y avoir des arêtes parallèles)
+        double best = std::numeric_limits<double>::max();
+        typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+        for (boost::tie(ei, ei_end) = out_edges(vertices[i], g); ei != ei_end; ++ei) {
+            if (target(*ei, g) == vertices[i + 1]) best = std::min<double>(best, get(weights, *ei));
+        }
+        length += best;
+    }
+    return length;
+}
+
+template <class G>
+PathResult toPathResult(const G& g, const std::vector<typename boost::graph_traits<G>::vertex_descriptor>& vertices) {
+    std::vector<NodeId> path;
+    auto ids = get(&NodeInfo::id, g);
+    for (auto v : vertices) path.push_back(get(ids, v));
+    return PathResult(pathLength(g, vertices), path);
+}
+
+// Distance à vol d'oiseau jusqu'à la cible ; légèrement réduite pour rester
+// admissible malgré les arrondis (les poids sont calculés avec la même formule)
+template <class G>
+class EuclideanHeuristic : public boost::astar_heuristic<G, double> {
+public:
+    typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+    EuclideanHeuristic(const G& g, Vertex goal)
+        : _x(get(&NodeInfo::x, g)), _y(get(&NodeInfo::y, g)), _z(get(&NodeInfo::z, g)),
+          _gx(get(_x, goal)), _gy(get(_y, goal)), _gz(get(_z, goal)) {}
+    double operator()(Vertex v) const {
+        double dx = get(_x, v) - _gx;
+        double dy = get(_y, v) - _gy;
+        double dz = get(_z, v) - _gz;
+        return std::sqrt(dx*dx + dy*dy + dz*dz) * (1.0 - 1e-12);
+    }
+private:
+    typedef decltype(get(&NodeInfo::x, std::declval<const G&>())) CoordMap;
+    CoordMap _x, _y, _z;
+    double _gx, _gy, _gz;
+};
+
+// Signal d'arrêt de l'A* : la cible vient d'être sortie du tas
+struct GoalReached {};
+
+template <class Vertex>
+class GoalVisitor : public boost::default_astar_visitor {
+public:
+    explicit GoalVisitor(Vertex goal) : _goal(goal) {}
+    template <class Graph>
+    void examine_vertex(Vertex u, const Graph&) {
+        if (u == _goal) throw GoalReached();
+    }
+private:
+    Vertex _goal;
+};
+
+// Tableaux de l'A* gardés d'une requête à l'autre (astar_search les réinitialise)
+template <class G>
+class AStarWorkspace {
+public:
+    typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+
+    explicit AStarWorkspace(std::size_t n) : _pred(n), _dist(n), _rank(n), _color(n) {}
+
+    PathResult run(const G& g, Vertex source, Vertex goal) {
+        auto index = get(boost::vertex_index, g);
+        try {
+            boost::astar_search(g, source, EuclideanHeuristic<G>(g, goal),
+                boost::visitor(GoalVisitor<Vertex>(goal))
+                .predecessor_map(boost::make_iterator_property_map(_pred.begin(), index))
+                .distance_map(boost::make_iterator_property_map(_dist.begin(), index))
+                .rank_map(boost::make_iterator_property_map(_rank.begin(), index))
+                .color_map(boost::make_iterator_property_map(_color.begin(), index))
+                .weight_map(get(&EdgeInfo::weight, g)));
+        } catch (const GoalReached&) {
+            // arrêt anticipé, le chemin vers la cible est définitif
+        }
+        if (_pred[goal] == goal && source != goal) return PathResult(-1, {});
+        std::vector<Vertex> vertices;
+        for (Vertex v = goal; ; v = _pred[v]) {
+            vertices.push_back(v);
+            if (v == source) break;
+        }
+        std::reverse(vertices.begin(), vertices.end());
+        return toPathResult(g, vertices);
+    }
+
+private:
+    std::vector<Vertex> _pred;
+    std::vector<double> _dist;
+    std::vector<double> _rank;
+    std::vector<boost::default_color_type> _color;
+};
+
+// Dijkstra bidirectionnel, même principe d'époques que DijkstraWorkspace
+template <class G>
+class BidirectionalWorkspace {
+public:
+    typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+
+    explicit BidirectionalWorkspace(std::size_t n) : _side{Side(n), Side(n)} {}
+
+    PathResult run(const G& g, Vertex source, Vertex goal) {
+        if (++_epoch == 0) {
+            for (Side& s : _side) {
+                std::fill(s.reached.begin(), s.reached.end(), 0);
+                std::fill(s.settled.begin(), s.settled.end(), 0);
+            }
+            _epoch = 1;
+        }
+        auto weights = get(&EdgeInfo::weight, g);
+        Side& fwd = _side[0];
+        Side& bwd = _side[1];
+        fwd.start(source, _epoch);
+        bwd.start(goal, _epoch);
+
+        // best = meilleure longueur connue d'un chemin passant par meet
+        double best = std::numeric_limits<double>::infinity();
+        Vertex meet = source;
+        bool found = false;
+        if (source == goal) {
+            best = 0.0;
+            found = true;
+        }
+
+        // on avance le front dont le minimum est le plus petit, arrêt quand la
+        // somme des deux minimums dépasse le meilleur chemin trouvé
+        while (!fwd.heap.empty() && !bwd.heap.empty()) {
+            if (fwd.heap.front().first + bwd.heap.front().first >= best) break;
+            int dir = fwd.heap.front().first <= bwd.heap.front().first ? 0 : 1;
+            Side& cur = _side[dir];
+            Side& other = _side[1 - dir];
+
+            std::pop_heap(cur.heap.begin(), cur.heap.end(), std::greater<HeapEntry>());
+            HeapEntry top = cur.heap.back();
+            cur.heap.pop_back();
+            Vertex u = top.second;
+            if (cur.settled[u] == _epoch) continue;
+            cur.settled[u] = _epoch;
+
+            typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+            for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+                Vertex v = target(*ei, g);
+                double d = top.first + get(weights, *ei);
+                if (cur.reached[v] != _epoch || d < cur.dist[v]) {
+                    cur.reach(v, d, u, _epoch);
+                }
+                if (other.reached[v] == _epoch && cur.dist[v] + other.dist[v] < best) {
+                    best = cur.dist[v] + other.dist[v];
+                    meet = v;
+                    found = true;
+                }
+            }
+        }
+        if (!found) return PathResult(-1, {});
+
+        // source -> meet par les prédécesseurs avant, puis meet -> cible par ceux du front arrière
+        std::vector<Vertex> vertices;
+        for (Vertex v = meet; ; v = fwd.pred[v]) {
+            vertices.push_back(v);
+            if (v == source) break;
+        }
+        std::reverse(vertices.begin(), vertices.end());
+        for (Vertex v = meet; v != goal; ) {
+            v = bwd.pred[v];
+            vertices.push_back(v);
+        }
+        return toPathResult(g, vertices);
+    }
+
+private:
+    typedef std::pair<double, Vertex> HeapEntry;
+
+    struct Side {
+        explicit Side(std::size_t n) : dist(n), pred(n), reached(n, 0), settled(n, 0) {}
+        void start(Vertex s, unsigned epoch) {
+            heap.clear();
+            reach(s, 0.0, s, epoch);
+        }
+        void reach(Vertex v, double d, Vertex from, unsigned epoch) {
+            reached[v] = epoch;
+            dist[v] = d;
+            pred[v] = from;
+            heap.push_back(HeapEntry(d, v));
+            std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+        }
+        std::vector<double> dist;
+        std::vector<Vertex> pred;
+        std::vector<unsigned> reached;
+        std::vector<unsigned> settled;
+        std::vector<HeapEntry> heap;
+    };
+
+    Side _side[2];
+    unsigned _epoch = 0;
+};
+
+#endif
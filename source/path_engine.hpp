@@ -0,0 +1,172 @@
+#ifndef PATH_ENGINE_HPP
+#define PATH_ENGINE_HPP
+
+// Moteur de requêtes de plus courts chemins en lot
+// - DijkstraWorkspace (dijkstra_workspace.hpp) : tableaux réutilisés d'une requête à l'autre,
+//   et d'un lot à l'autre via WorkspacePool (workspace_pool.hpp)
+// - PathQueryEngine : regroupe les paires par source et répartit les sources
+//   entre plusieurs threads, chacun avec son propre workspace ; les résultats sont
+//   rangés dans l'ordre des paires, l'écriture du CSV se fait après le calcul.
+//   En mode A* / bidirectionnel (p2p_search.hpp) ou avec un index de distances
+//   (distance_index.hpp) ce sont les paires qui sont réparties.
+//   En mode delta-stepping (delta_stepping.hpp) les sources sont traitées l'une après
+//   l'autre et tous les threads travaillent ensemble sur chaque recherche.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include "graph_types.hpp"
+#include "dijkstra_workspace.hpp"
+#include "p2p_search.hpp"
+#include "distance_index.hpp"
+#include "delta_stepping.hpp"
+#include "metrics.hpp"
+#include "workspace_pool.hpp"
+
+template <class G>
+class PathQueryEngine {
+public:
+    typedef typename boost::graph_traits<G>::vertex_descriptor Vertex;
+
+    // avec un index de distances (distance_index.hpp), les requêtes passent par l'index
+    explicit PathQueryEngine(const G& g, const DistanceIndex* index = nullptr) : _g(g), _index(index) {}
+
+    // Résout toutes les paires (IDs du CSV), un Dijkstra par source distincte,
+    // les sources sont distribuées dynamiquement entre `threads` workers (0 = tous les coeurs)
+    // en mode A* ou bidirectionnel, une recherche point à point par paire
+    // en mode delta-stepping, les `threads` workers partagent chaque recherche
+    // micros : temps de calcul de chaque paire en µs (une recherche partagée par
+    // plusieurs paires, Dijkstra groupé par source, compte pour chacune d'elles)
+    std::vector<PathResult> run(const std::vector<NodePair>& nodePairs, unsigned threads = 1,
+                                PathMode mode = PathMode::Dijkstra, std::vector<double>* micros = nullptr) const {
+        ScopedPhase phase(Phase::ShortestPaths);
+        const std::size_t n = num_vertices(_g);
+        std::vector<PathResult> results(nodePairs.size(), PathResult(-1, {}));
+        if (micros) micros->assign(nodePairs.size(), 0.0);
+        auto record = [micros](std::size_t i, std::chrono::steady_clock::time_point t0) {
+            if (micros) {
+                (*micros)[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+            }
+        };
+
+        // Regrouper les paires valides par source (ordre de première apparition)
+        // les IDs du CSV sont convertis une fois en indices (voir node_ids.hpp)
+        std::vector<Vertex> sources;
+        std::vector<std::size_t> validPairs;
+        std::vector<Vertex> starts(nodePairs.size()), ends(nodePairs.size());
+        std::map<Vertex, std::vector<std::size_t>> pairsBySource;
+        for (std::size_t i = 0; i < nodePairs.size(); ++i) {
+            std::size_t start = nodeIndex(_g, nodePairs[i].first);
+            std::size_t end = nodeIndex(_g, nodePairs[i].second);
+            if (start >= n || end >= n) {
+                std::cerr << "Erreur : Indices de nœuds invalides." << std::endl;
+                continue;
+            }
+            starts[i] = static_cast<Vertex>(start);
+            ends[i] = static_cast<Vertex>(end);
+            validPairs.push_back(i);
+            auto& group = pairsBySource[starts[i]];
+            if (group.empty()) sources.push_back(starts[i]);
+            group.push_back(i);
+        }
+        Metrics::add(Counter::PathQueries, validPairs.size());
+
+        if (_index) {
+            typedef DistanceIndex::Workspace<G> IndexWorkspace;
+            forEachParallel<IndexWorkspace>(validPairs.size(), threads, [&](IndexWorkspace& ws, std::size_t k) {
+                std::size_t i = validPairs[k];
+                auto t0 = std::chrono::steady_clock::now();
+                results[i] = _index->query(_g, nodePairs[i].first, nodePairs[i].second, ws);
+                record(i, t0);
+            });
+            return results;
+        }
+        if (mode == PathMode::AStar) {
+            forEachParallel<AStarWorkspace<G>>(validPairs.size(), threads, [&](AStarWorkspace<G>& ws, std::size_t k) {
+                std::size_t i = validPairs[k];
+                auto t0 = std::chrono::steady_clock::now();
+                results[i] = ws.run(_g, starts[i], ends[i]);
+                record(i, t0);
+            });
+            return results;
+        }
+        // le front arrière suivrait les arcs à l'envers : pas de recherche bidirectionnelle en orienté
+        if (mode == PathMode::Bidirectional && !boost::is_directed_graph<G>::value) {
+            forEachParallel<BidirectionalWorkspace<G>>(validPairs.size(), threads,
+                                                       [&](BidirectionalWorkspace<G>& ws, std::size_t k) {
+                std::size_t i = validPairs[k];
+                auto t0 = std::chrono::steady_clock::now();
+                results[i] = ws.run(_g, starts[i], ends[i]);
+                record(i, t0);
+            });
+            return results;
+        }
+
+        if (mode == PathMode::DeltaStepping) {
+            typename WorkspacePool<DeltaSteppingWorkspace<G>>::Lease ws =
+                WorkspacePool<DeltaSteppingWorkspace<G>>::acquire(num_vertices(_g));
+            const double delta = deltaSteppingWidth(_g);
+            std::vector<Vertex> targets;
+            for (Vertex source : sources) {
+                auto t0 = std::chrono::steady_clock::now();
+                const std::vector<std::size_t>& group = pairsBySource[source];
+                targets.clear();
+                for (std::size_t i : group) targets.push_back(ends[i]);
+                ws->run(_g, source, targets, threads, delta);
+                for (std::size_t i : group) results[i] = ws->path(_g, source, ends[i]);
+                for (std::size_t i : group) record(i, t0);
+            }
+            return results;
+        }
+
+        std::vector<const std::vector<std::size_t>*> groups;
+        for (Vertex s : sources) groups.push_back(&pairsBySource[s]);
+        forEachParallel<DijkstraWorkspace<G>>(sources.size(), threads, [&](DijkstraWorkspace<G>& ws, std::size_t k) {
+            auto t0 = std::chrono::steady_clock::now();
+            Vertex source = sources[k];
+            thread_local std::vector<Vertex> targets;  // capacité gardée d'une source à l'autre
+            targets.clear();
+            for (std::size_t i : *groups[k]) targets.push_back(ends[i]);
+            ws.run(_g, source, targets);
+            for (std::size_t i : *groups[k]) results[i] = ws.path(_g, source, ends[i]);
+            for (std::size_t i : *groups[k]) record(i, t0);
+        });
+        return results;
+    }
+
+private:
+    // Chaque worker prend la prochaine tâche libre avec son propre workspace,
+    // emprunté à WorkspacePool (gardé d'un appel à l'autre) ;
+    // chaque case de results n'est écrite que par le worker qui traite la tâche
+    template <class Workspace, class Task>
+    void forEachParallel(std::size_t count, unsigned threads, Task task) const {
+        const std::size_t n = num_vertices(_g);
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, count)));
+
+        std::atomic<std::size_t> next(0);
+        auto worker = [&]() {
+            typename WorkspacePool<Workspace>::Lease ws = WorkspacePool<Workspace>::acquire(n);
+            for (std::size_t k = next++; k < count; k = next++) task(*ws, k);
+        };
+        if (threads <= 1) {
+            worker();
+        } else {
+            std::vector<std::thread> pool;
+            for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+            for (auto& th : pool) th.join();
+        }
+    }
+
+private:
+    const G& _g;
+    const DistanceIndex* _index;
+};
+
+#endif
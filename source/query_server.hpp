@@ -0,0 +1,338 @@
+#ifndef QUERY_SERVER_HPP
+#define QUERY_SERVER_HPP
+
+// Mode serveur : le graphe est chargé une fois, les requêtes arrivent ensuite en
+// lignes de texte sur stdin ou sur un socket Unix (un thread par connexion).
+// Requêtes (IDs du CSV) :
+//   path S T        -> ok <µs> <longueur> <chemin a->b->c | No path>
+//   degree N        -> ok <µs> <degré>
+//   connected       -> ok <µs> <true|false> <nombre de composantes>
+//   connected S T   -> ok <µs> <true|false>   (même composante)
+//   cycle           -> ok <µs> <true|false>
+//   stats           -> ok <µs> <nœuds> <arêtes>
+//   nearest X Y Z   -> ok <µs> <id>:<distance>             (nœud le plus proche de la position)
+//   knn K X Y Z     -> ok <µs> <id>:<distance> ...          (K plus proches, du plus proche au plus lointain)
+//   within R X Y Z  -> ok <µs> <nombre> <id>:<distance> ... (nœuds à distance <= R, par ID croissant)
+//   route X1 Y1 Z1 X2 Y2 Z2 -> comme path, entre les nœuds les plus proches des deux positions
+//   quit            -> fin de la session
+// Une réponse par requête, dans l'ordre (lignes vides ignorées) ;
+// error <µs> <message> en cas de requête invalide.
+// Lots : toutes les lignes déjà reçues (au plus kMaxBatch) sont traitées ensemble, les
+// chemins d'un lot passent en une fois par PathQueryEngine (groupés par source, threads) ;
+// <µs> est le temps de calcul de la requête. Un résumé par lot est écrit sur stderr.
+// Les requêtes par position passent par l'index spatial (spatial_index.hpp) ; les extrémités
+// des route d'un lot sont résolues en une fois (nearestBatch) avant le calcul des chemins.
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "graph_types.hpp"
+#include "graph_summary.hpp"
+#include "path_engine.hpp"
+#include "metrics.hpp"
+#include "spatial_index.hpp"
+
+// Lecture de lignes sur un descripteur, avec un tampon qui permet de savoir si
+// d'autres lignes complètes sont déjà arrivées (pour constituer les lots)
+class LineReader {
+public:
+    explicit LineReader(int fd) : _fd(fd) {}
+
+    // Bloque jusqu'à une ligne complète ; faux à la fin du flux
+    bool readLine(std::string& line) {
+        for (;;) {
+            std::size_t eol = _buffer.find('\n', _pos);
+            if (eol != std::string::npos) {
+                line.assign(_buffer, _pos, eol - _pos);
+                _pos = eol + 1;
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                return true;
+            }
+            if (_eof) {
+                if (_pos >= _buffer.size()) return false;
+                line.assign(_buffer, _pos, std::string::npos);  // dernière ligne sans fin de ligne
+                _pos = _buffer.size();
+                return true;
+            }
+            _buffer.erase(0, _pos);
+            _pos = 0;
+            char chunk[65536];
+            ssize_t got = ::read(_fd, chunk, sizeof chunk);
+            if (got < 0 && errno == EINTR) continue;  // interrompu par un signal : on relit
+            if (got <= 0) _eof = true;
+            else _buffer.append(chunk, static_cast<std::size_t>(got));
+        }
+    }
+
+    bool hasBufferedLine() const { return _buffer.find('\n', _pos) != std::string::npos; }
+
+private:
+    int _fd;
+    std::string _buffer;
+    std::size_t _pos = 0;
+    bool _eof = false;
+};
+
+template <class G>
+class QueryServer {
+public:
+    static constexpr std::size_t kMaxBatch = 4096;
+    static constexpr std::size_t kMaxNeighbors = 10000;  // K maximal de knn
+
+    QueryServer(const G& g, const GraphSummary& summary, unsigned threads = 1,
+                PathMode mode = PathMode::Dijkstra, const DistanceIndex* index = nullptr,
+                const SpatialIndex* spatial = nullptr)
+        : _g(g), _summary(summary), _threads(threads), _mode(mode), _index(index), _spatial(spatial) {}
+
+    // Sert une session : requêtes lues sur in, réponses écrites sur out
+    void serve(int in, int out) const {
+        LineReader reader(in);
+        std::vector<std::string> batch;
+        std::string line;
+        bool quit = false;
+        std::size_t batchCount = 0;
+        while (!quit && reader.readLine(line)) {
+            batch.clear();
+            batch.push_back(line);
+            while (batch.size() < kMaxBatch && reader.hasBufferedLine() && reader.readLine(line)) {
+                batch.push_back(line);
+            }
+            auto t0 = std::chrono::steady_clock::now();
+            std::string responses = answerBatch(batch, quit);
+            if (!writeAll(out, responses)) break;
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            std::cerr << "lot " << ++batchCount << " : " << batch.size() << " requête(s) en " << ms << " ms" << std::endl;
+        }
+    }
+
+    // Sert les connexions d'un socket Unix, une session par client (jusqu'à l'arrêt du processus)
+    bool serveUnixSocket(const std::string& path) const {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (fd < 0 || path.size() >= sizeof addr.sun_path) {
+            std::cerr << "Erreur : Impossible de créer le socket " << path << std::endl;
+            if (fd >= 0) ::close(fd);
+            return false;
+        }
+        path.copy(addr.sun_path, path.size());
+        ::unlink(path.c_str());
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0 || ::listen(fd, 16) != 0) {
+            std::cerr << "Erreur : Impossible d'écouter sur " << path << std::endl;
+            ::close(fd);
+            return false;
+        }
+        std::signal(SIGPIPE, SIG_IGN);  // un client qui part ne doit pas arrêter le serveur
+        std::cout << "Serveur en écoute sur " << path << std::endl;
+        for (;;) {
+            int client = ::accept(fd, nullptr, nullptr);
+            if (client < 0) continue;
+            std::thread([this, client]() {
+                serve(client, client);
+                ::close(client);
+            }).detach();
+        }
+    }
+
+private:
+    enum class Kind {
+        Path, Degree, Connected, SameComponent, Cycle, Stats, Nearest, KNearest, Within, Route, Quit, Invalid
+    };
+
+    struct Request {
+        Kind kind = Kind::Invalid;
+        NodeId a = 0, b = 0;  // IDs du CSV
+        Point3 from, to;      // requêtes par position
+        std::size_t k = 0;    // knn
+        double radius = 0;    // within
+        std::string error;
+    };
+
+    Request parse(const std::string& line) const {
+        std::istringstream in(line);
+        std::string verb;
+        in >> verb;
+        Request r;
+        const std::size_t n = num_vertices(_g);
+        auto known = [&](NodeId id) { return nodeIndex(_g, id) < n; };
+        auto readIds = [&](int count) {
+            if (count >= 1 && !(in >> r.a)) return false;
+            if (count >= 2 && !(in >> r.b)) return false;
+            std::string extra;
+            if (in >> extra) return false;
+            return (count < 1 || known(r.a)) && (count < 2 || known(r.b));
+        };
+        if (verb == "path") r.kind = readIds(2) ? Kind::Path : Kind::Invalid;
+        else if (verb == "degree") r.kind = readIds(1) ? Kind::Degree : Kind::Invalid;
+        else if (verb == "connected") {
+            std::string rest;
+            std::getline(in, rest);
+            std::istringstream args(rest);
+            if (rest.find_first_not_of(" \t") == std::string::npos) r.kind = Kind::Connected;
+            else if (args >> r.a >> r.b && known(r.a) && known(r.b)) r.kind = Kind::SameComponent;
+        }
+        else if (verb == "cycle") r.kind = Kind::Cycle;
+        else if (verb == "stats") r.kind = Kind::Stats;
+        else if (verb == "nearest" || verb == "knn" || verb == "within" || verb == "route") {
+            auto readPoint = [&in](Point3& p) { return static_cast<bool>(in >> p.x >> p.y >> p.z); };
+            bool ok = true;
+            long long k = 0;
+            if (verb == "knn") ok = (in >> k) && k >= 1 && k <= static_cast<long long>(kMaxNeighbors);
+            r.k = static_cast<std::size_t>(k);
+            if (verb == "within") ok = (in >> r.radius) && r.radius >= 0;
+            ok = ok && readPoint(r.from) && (verb != "route" || readPoint(r.to));
+            std::string extra;
+            if (ok && !(in >> extra)) {
+                r.kind = verb == "nearest" ? Kind::Nearest : verb == "knn" ? Kind::KNearest
+                       : verb == "within" ? Kind::Within : Kind::Route;
+            }
+            if (r.kind != Kind::Invalid && (!_spatial || _spatial->empty())) {
+                r.kind = Kind::Invalid;
+                r.error = "pas d'index spatial : " + line;
+                return r;
+            }
+        }
+        else if (verb == "quit") r.kind = Kind::Quit;
+        if (r.kind == Kind::Invalid) r.error = "requête invalide : " + line;
+        return r;
+    }
+
+    std::string answerBatch(const std::vector<std::string>& lines, bool& quit) const {
+        ScopedPhase phase(Phase::ServeBatch);
+        std::vector<Request> requests;
+        std::vector<NodePair> pairs;
+        std::vector<std::size_t> pairOf(lines.size(), 0);
+        for (const std::string& line : lines) {
+            if (line.find_first_not_of(" \t") == std::string::npos) continue;  // lignes vides ignorées
+            requests.push_back(parse(line));
+            if (requests.back().kind == Kind::Quit) break;  // la suite du lot est ignorée
+            if (requests.back().kind == Kind::Path || requests.back().kind == Kind::Route) {
+                pairOf[requests.size() - 1] = pairs.size();
+                pairs.push_back(std::make_pair(requests.back().a, requests.back().b));
+            }
+        }
+        Metrics::add(Counter::Requests, requests.size());
+
+        // extrémités des route : nœuds les plus proches, tous en un appel
+        std::vector<Point3> ends;
+        for (const Request& r : requests) {
+            if (r.kind != Kind::Route) continue;
+            ends.push_back(r.from);
+            ends.push_back(r.to);
+        }
+        if (!ends.empty()) {
+            std::vector<SpatialIndex::Neighbor> nearest = _spatial->nearestBatch(ends, _threads);
+            auto ids = get(&NodeInfo::id, _g);
+            std::size_t e = 0;
+            for (std::size_t i = 0; i < requests.size(); ++i) {
+                if (requests[i].kind != Kind::Route) continue;
+                pairs[pairOf[i]].first = get(ids, nearest[e++].vertex);
+                pairs[pairOf[i]].second = get(ids, nearest[e++].vertex);
+            }
+        }
+        std::vector<double> micros;
+        std::vector<PathResult> paths;
+        if (!pairs.empty()) paths = PathQueryEngine<G>(_g, _index).run(pairs, _threads, _mode, &micros);
+
+        std::ostringstream out;
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            const Request& r = requests[i];
+            auto t0 = std::chrono::steady_clock::now();
+            std::ostringstream payload;
+            switch (r.kind) {
+            case Kind::Path:
+            case Kind::Route: {
+                const PathResult& p = paths[pairOf[i]];
+                payload << std::fixed << std::setprecision(2) << p.first << " ";
+                if (p.second.empty()) payload << "No path";
+                for (std::size_t k = 0; k < p.second.size(); ++k) payload << (k ? "->" : "") << p.second[k];
+                break;
+            }
+            case Kind::Degree:
+                payload << _summary.degree[nodeIndex(_g, r.a)];
+                break;
+            case Kind::Connected:
+                payload << (_summary.connected() ? "true " : "false ") << _summary.components.count();
+                break;
+            case Kind::SameComponent: {
+                const auto& c = _summary.components.component;
+                payload << (c[nodeIndex(_g, r.a)] == c[nodeIndex(_g, r.b)] ? "true" : "false");
+                break;
+            }
+            case Kind::Cycle:
+                payload << (_summary.hasCycle ? "true" : "false");
+                break;
+            case Kind::Stats:
+                payload << _summary.vertices << " " << _summary.edges;
+                break;
+            case Kind::Nearest:
+                writeNeighbors(payload, std::vector<SpatialIndex::Neighbor>(1, _spatial->nearest(r.from)));
+                break;
+            case Kind::KNearest:
+                writeNeighbors(payload, _spatial->kNearest(r.from, r.k));
+                break;
+            case Kind::Within: {
+                std::vector<SpatialIndex::Neighbor> found = _spatial->radius(r.from, r.radius);
+                payload << found.size();
+                if (!found.empty()) payload << " ";
+                writeNeighbors(payload, found);
+                break;
+            }
+            case Kind::Quit:
+                quit = true;
+                payload << "bye";
+                break;
+            case Kind::Invalid:
+                payload << r.error;
+                break;
+            }
+            double us = r.kind == Kind::Path || r.kind == Kind::Route
+                ? micros[pairOf[i]]
+                : std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+            out << (r.kind == Kind::Invalid ? "error " : "ok ") << std::fixed << std::setprecision(1) << us
+                << " " << payload.str() << "\n";
+        }
+        return out.str();
+    }
+
+    // <id>:<distance> séparés par des espaces
+    void writeNeighbors(std::ostream& out, const std::vector<SpatialIndex::Neighbor>& neighbors) const {
+        auto ids = get(&NodeInfo::id, _g);
+        out << std::fixed << std::setprecision(2);
+        for (std::size_t k = 0; k < neighbors.size(); ++k) {
+            out << (k ? " " : "") << get(ids, neighbors[k].vertex) << ":" << neighbors[k].distance;
+        }
+    }
+
+    static bool writeAll(int fd, const std::string& data) {
+        std::size_t done = 0;
+        while (done < data.size()) {
+            ssize_t n = ::write(fd, data.data() + done, data.size() - done);
+            if (n < 0 && errno == EINTR) continue;  // interrompu par un signal : on réessaie
+            if (n <= 0) return false;
+            done += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    const G& _g;
+    const GraphSummary& _summary;
+    unsigned _threads;
+    PathMode _mode;
+    const DistanceIndex* _index;
+    const SpatialIndex* _spatial;
+};
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef SOA_PROPERTIES_HPP
+#define SOA_PROPERTIES_HPP
+
+// Couche de propriétés en structure de tableaux (SoA) :
+// x[], y[], z[], poids[] contigus et drapeaux inPath dans un bitset à part.
+// Une relaxation de Dijkstra ne charge plus que les poids, un calcul de
+// coordonnées ne charge plus les IDs. Les tableaux sont exposés aux algorithmes
+// BGL sous forme de property maps (voir get(...) dans csr_graph.hpp).
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/property_map/property_map.hpp>
+#include "graph_types.hpp"
+#include "weights_simd.hpp"
+
+// Clé -> position dans les tableaux : un sommet est déjà un indice,
+// les autres clés (descripteurs d'arête du CSR) fournissent leur surcharge
+inline std::size_t soaKeyIndex(std::size_t v) { return v; }
+
+// Property map sur un tableau contigu (T peut être const pour un accès en lecture)
+template <class Key, class T>
+class SoaArrayMap : public boost::put_get_helper<T&, SoaArrayMap<Key, T>> {
+public:
+    typedef Key key_type;
+    typedef typename std::remove_const<T>::type value_type;
+    typedef T& reference;
+    typedef boost::lvalue_property_map_tag category;
+
+    SoaArrayMap() {}
+    explicit SoaArrayMap(T* base) : _base(base) {}
+    reference operator[](const Key& k) const { return _base[soaKeyIndex(k)]; }
+private:
+    T* _base = nullptr;
+};
+
+// Property map sur un bitset : un bit par arête au lieu d'un bool dans chaque struct
+template <class Key, class Bits>
+class SoaBitMap {
+public:
+    typedef Key key_type;
+    typedef bool value_type;
+    typedef bool reference;
+    typedef boost::read_write_property_map_tag category;
+
+    SoaBitMap() {}
+    explicit SoaBitMap(Bits* bits) : _bits(bits) {}
+
+    friend bool get(const SoaBitMap& m, const Key& k) { return m._bits->test(soaKeyIndex(k)); }
+    friend void put(const SoaBitMap& m, const Key& k, bool value) { m._bits->set(soaKeyIndex(k), value); }
+private:
+    Bits* _bits = nullptr;
+};
+
+// Tableau contigu qui possède ses éléments (std::vector) ou qui pointe dans une
+// zone projetée en mémoire (snapshot binaire, voir graph_snapshot.hpp) : dans ce
+// cas aucune copie n'est faite et le propriétaire de la projection doit survivre
+template <class T>
+class SoaArray {
+public:
+    SoaArray() {}
+    SoaArray(const SoaArray& o) { *this = o; }
+    SoaArray& operator=(const SoaArray& o) {
+        _own = o._own;
+        if (o.isView()) view(o._data, o._size);
+        else sync();
+        return *this;
+    }
+    SoaArray(SoaArray&& o) noexcept { *this = std::move(o); }
+    SoaArray& operator=(SoaArray&& o) noexcept {
+        T* data = o._data;
+        std::size_t size = o._size;
+        bool wasView = o.isView();
+        _own = std::move(o._own);
+        if (wasView) {
+            _data = data;
+            _size = size;
+        } else {
+            sync();
+        }
+        o.sync();
+        return *this;
+    }
+
+    // Bascule en vue sur [data, data + size) et libère le stockage propre
+    void view(T* data, std::size_t size) {
+        std::vector<T>().swap(_own);
+        _data = data;
+        _size = size;
+    }
+    bool isView() const { return _size != 0 && _data != _own.data(); }
+
+    // Les opérations qui changent la taille ne concernent que le stockage propre
+    void resize(std::size_t n) { _own.resize(n); sync(); }
+    void assign(std::size_t n, const T& value) { _own.assign(n, value); sync(); }
+    void reserve(std::size_t n) { _own.reserve(n); sync(); }
+    void push_back(const T& value) { _own.push_back(value); sync(); }
+
+    T* data() { return _data; }
+    const T* data() const { return _data; }
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    T& operator[](std::size_t i) { return _data[i]; }
+    const T& operator[](std::size_t i) const { return _data[i]; }
+    T* begin() { return _data; }
+    T* end() { return _data + _size; }
+    const T* begin() const { return _data; }
+    const T* end() const { return _data + _size; }
+
+private:
+    void sync() {
+        _data = _own.data();
+        _size = _own.size();
+    }
+
+    std::vector<T> _own;
+    T* _data = nullptr;
+    std::size_t _size = 0;
+};
+
+// Coordonnées des nœuds en SoA
+struct NodeCoords {
+    SoaArray<double> x, y, z;
+
+    void resize(std::size_t n) {
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+    }
+    std::size_t size() const { return x.size(); }
+
+    // Sélectionne le tableau correspondant à un membre de NodeInfo (&NodeInfo::x, ...)
+    double* array(double NodeInfo::*member) {
+        return member == &NodeInfo::x ? x.data() : member == &NodeInfo::y ? y.data() : z.data();
+    }
+    const double* array(double NodeInfo::*member) const {
+        return member == &NodeInfo::x ? x.data() : member == &NodeInfo::y ? y.data() : z.data();
+    }
+};
+
+// Copie les coordonnées d'un graphe (n'importe quel backend) en SoA
+template <class G>
+NodeCoords nodeCoordsOf(const G& g) {
+    NodeCoords coords;
+    coords.resize(num_vertices(g));
+    auto xs = get(&NodeInfo::x, g);
+    auto ys = get(&NodeInfo::y, g);
+    auto zs = get(&NodeInfo::z, g);
+    typename boost::graph_traits<G>::vertex_iterator vi, vi_end;
+    for (boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+        coords.x[*vi] = get(xs, *vi);
+        coords.y[*vi] = get(ys, *vi);
+        coords.z[*vi] = get(zs, *vi);
+    }
+    return coords;
+}
+
+// Arêtes lues dans edges.csv, en SoA : indices 0-based puis poids calculés à part
+struct EdgeBatch {
+    std::vector<int> source, target;
+    std::vector<double> weight;
+
+    void reserve(std::size_t m) {
+        source.reserve(m);
+        target.reserve(m);
+    }
+    void push(int s, int t) {
+        source.push_back(s);
+        target.push_back(t);
+    }
+    std::size_t size() const { return source.size(); }
+};
+
+// Poids = distance euclidienne 3D, en une passe séparée du parsing
+// sur des tableaux contigus (noyau SIMD de weights_simd.hpp)
+inline void computeEdgeWeights(const NodeCoords& coords, EdgeBatch& batch) {
+    batch.weight.resize(batch.size());
+    computeWeightsBatch(coords.x.data(), coords.y.data(), coords.z.data(),
+                        batch.source.data(), batch.target.data(), batch.weight.data(), batch.size());
+}
+
+#endif
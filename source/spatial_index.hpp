@@ -0,0 +1,258 @@
+#ifndef SPATIAL_INDEX_HPP
+#define SPATIAL_INDEX_HPP
+
+// Index spatial sur les coordonnées (x, y, z) des nœuds : arbre k-d implicite
+// - les points sont rangés dans l'ordre de l'arbre (tableaux x, y, z contigus) : le
+//   nœud d'un intervalle [lo, hi) est son milieu, coupé selon l'axe le plus étendu
+//   (sauvé dans _axis), les petits intervalles sont parcourus linéairement
+// - nearest / kNearest / radius en O(log n) en moyenne au lieu d'un parcours de tous
+//   les nœuds ; distances euclidiennes 3D comme les poids des arêtes
+// - à distance égale, le sommet de plus petit indice l'emporte (même réponse qu'un
+//   parcours linéaire)
+// Les résultats sont des indices de sommets (ID du CSV = get(&NodeInfo::id, g)).
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <boost/graph/graph_traits.hpp>
+#include "graph_types.hpp"
+
+struct Point3 {
+    double x = 0, y = 0, z = 0;
+};
+
+// "x,y,z" (ou séparés par des espaces)
+inline bool parsePoint3(const std::string& text, Point3& p) {
+    std::string spaced = text;
+    std::replace(spaced.begin(), spaced.end(), ',', ' ');
+    std::istringstream in(spaced);
+    std::string extra;
+    return (in >> p.x >> p.y >> p.z) && !(in >> extra);
+}
+
+class SpatialIndex {
+public:
+    struct Neighbor {
+        std::size_t vertex;
+        double distance;
+    };
+
+    SpatialIndex() {}
+
+    template <class G>
+    explicit SpatialIndex(const G& g) {
+        auto xs = get(&NodeInfo::x, g);
+        auto ys = get(&NodeInfo::y, g);
+        auto zs = get(&NodeInfo::z, g);
+        const std::size_t n = num_vertices(g);
+        std::vector<double> x(n), y(n), z(n);
+        for (std::size_t v = 0; v < n; ++v) {
+            x[v] = get(xs, v);
+            y[v] = get(ys, v);
+            z[v] = get(zs, v);
+        }
+        build(x, y, z);
+    }
+
+    explicit SpatialIndex(const std::vector<NodeInfo>& nodes) {
+        const std::size_t n = nodes.size();
+        std::vector<double> x(n), y(n), z(n);
+        for (std::size_t v = 0; v < n; ++v) {
+            x[v] = nodes[v].x;
+            y[v] = nodes[v].y;
+            z[v] = nodes[v].z;
+        }
+        build(x, y, z);
+    }
+
+    std::size_t size() const { return _vertex.size(); }
+    bool empty() const { return _vertex.empty(); }
+
+    // Sommet le plus proche (vertex = size() si l'index est vide)
+    Neighbor nearest(const Point3& q) const {
+        Best best = { std::numeric_limits<double>::infinity(), _vertex.size() };
+        if (!empty()) nearest(0, size(), q, best);
+        return Neighbor{ best.vertex, std::sqrt(best.dist2) };
+    }
+
+    // Les k sommets les plus proches, du plus proche au plus lointain
+    std::vector<Neighbor> kNearest(const Point3& q, std::size_t k) const {
+        std::vector<Best> heap;  // tas max sur (distance, sommet) : le pire en tête
+        if (k > 0 && !empty()) {
+            heap.reserve(std::min(k, size()));
+            kNearest(0, size(), q, std::min(k, size()), heap);
+        }
+        std::sort_heap(heap.begin(), heap.end());
+        std::vector<Neighbor> out;
+        out.reserve(heap.size());
+        for (const Best& b : heap) out.push_back(Neighbor{ b.vertex, std::sqrt(b.dist2) });
+        return out;
+    }
+
+    // Sommets à distance <= r, par indice croissant
+    std::vector<Neighbor> radius(const Point3& q, double r) const {
+        std::vector<Neighbor> out;
+        if (!empty() && r >= 0) radius(0, size(), q, r, r * r, out);
+        std::sort(out.begin(), out.end(), [](const Neighbor& a, const Neighbor& b) { return a.vertex < b.vertex; });
+        return out;
+    }
+
+    // Plus proche sommet de chaque point, points répartis entre `threads` threads (0 = tous les coeurs)
+    std::vector<Neighbor> nearestBatch(const std::vector<Point3>& points, unsigned threads = 1) const {
+        std::vector<Neighbor> out(points.size());
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, points.size() / 1024)));
+        auto work = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) out[i] = nearest(points[i]);
+        };
+        if (threads <= 1) {
+            work(0, points.size());
+        } else {
+            std::vector<std::thread> pool;
+            const std::size_t chunk = (points.size() + threads - 1) / threads;
+            for (unsigned t = 0; t < threads; ++t) {
+                std::size_t begin = std::min(points.size(), t * chunk);
+                pool.emplace_back(work, begin, std::min(points.size(), begin + chunk));
+            }
+            for (auto& th : pool) th.join();
+        }
+        return out;
+    }
+
+private:
+    static constexpr std::size_t kLeaf = 8;  // intervalles parcourus linéairement
+
+    // Candidat : comparé sur (distance², sommet)
+    struct Best {
+        double dist2;
+        std::size_t vertex;
+        bool operator<(const Best& o) const { return dist2 < o.dist2 || (dist2 == o.dist2 && vertex < o.vertex); }
+    };
+
+    void build(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z) {
+        const std::size_t n = x.size();
+        std::vector<std::uint32_t> order(n);
+        for (std::size_t v = 0; v < n; ++v) order[v] = static_cast<std::uint32_t>(v);
+        _axis.assign(n, 0);
+        const double* coords[3] = { x.data(), y.data(), z.data() };
+        split(order, coords, 0, n);
+        _x.resize(n);
+        _y.resize(n);
+        _z.resize(n);
+        _vertex.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            _x[i] = x[order[i]];
+            _y[i] = y[order[i]];
+            _z[i] = z[order[i]];
+            _vertex[i] = order[i];
+        }
+    }
+
+    // Médiane de [lo, hi) selon l'axe le plus étendu, puis les deux moitiés
+    void split(std::vector<std::uint32_t>& order, const double* const coords[3], std::size_t lo, std::size_t hi) {
+        while (hi - lo > kLeaf) {
+            double low[3], high[3];
+            for (int a = 0; a < 3; ++a) low[a] = high[a] = coords[a][order[lo]];
+            for (std::size_t i = lo + 1; i < hi; ++i) {
+                for (int a = 0; a < 3; ++a) {
+                    low[a] = std::min(low[a], coords[a][order[i]]);
+                    high[a] = std::max(high[a], coords[a][order[i]]);
+                }
+            }
+            int axis = 0;
+            for (int a = 1; a < 3; ++a) {
+                if (high[a] - low[a] > high[axis] - low[axis]) axis = a;
+            }
+            const double* c = coords[axis];
+            std::size_t mid = lo + (hi - lo) / 2;
+            std::nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi,
+                             [c](std::uint32_t a, std::uint32_t b) { return c[a] < c[b] || (c[a] == c[b] && a < b); });
+            _axis[mid] = static_cast<std::uint8_t>(axis);
+            split(order, coords, lo, mid);
+            lo = mid + 1;
+        }
+    }
+
+    double coord(std::size_t i, int axis) const { return axis == 0 ? _x[i] : axis == 1 ? _y[i] : _z[i]; }
+    static double coord(const Point3& q, int axis) { return axis == 0 ? q.x : axis == 1 ? q.y : q.z; }
+
+    Best candidate(std::size_t i, const Point3& q) const {
+        double dx = _x[i] - q.x, dy = _y[i] - q.y, dz = _z[i] - q.z;
+        return Best{ dx * dx + dy * dy + dz * dz, _vertex[i] };
+    }
+
+    void nearest(std::size_t lo, std::size_t hi, const Point3& q, Best& best) const {
+        if (hi - lo <= kLeaf) {
+            for (std::size_t i = lo; i < hi; ++i) best = std::min(best, candidate(i, q));
+            return;
+        }
+        std::size_t mid = lo + (hi - lo) / 2;
+        int axis = _axis[mid];
+        double diff = coord(q, axis) - coord(mid, axis);
+        best = std::min(best, candidate(mid, q));
+        // d'abord le côté du point, l'autre seulement s'il peut contenir mieux (ou aussi bien)
+        if (diff < 0) {
+            nearest(lo, mid, q, best);
+            if (diff * diff <= best.dist2) nearest(mid + 1, hi, q, best);
+        } else {
+            nearest(mid + 1, hi, q, best);
+            if (diff * diff <= best.dist2) nearest(lo, mid, q, best);
+        }
+    }
+
+    void offer(std::vector<Best>& heap, std::size_t k, const Best& b) const {
+        if (heap.size() < k) {
+            heap.push_back(b);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (b < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = b;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    void kNearest(std::size_t lo, std::size_t hi, const Point3& q, std::size_t k, std::vector<Best>& heap) const {
+        if (hi - lo <= kLeaf) {
+            for (std::size_t i = lo; i < hi; ++i) offer(heap, k, candidate(i, q));
+            return;
+        }
+        std::size_t mid = lo + (hi - lo) / 2;
+        int axis = _axis[mid];
+        double diff = coord(q, axis) - coord(mid, axis);
+        offer(heap, k, candidate(mid, q));
+        std::size_t nearLo = diff < 0 ? lo : mid + 1, nearHi = diff < 0 ? mid : hi;
+        std::size_t farLo = diff < 0 ? mid + 1 : lo, farHi = diff < 0 ? hi : mid;
+        kNearest(nearLo, nearHi, q, k, heap);
+        if (heap.size() < k || diff * diff <= heap.front().dist2) kNearest(farLo, farHi, q, k, heap);
+    }
+
+    void radius(std::size_t lo, std::size_t hi, const Point3& q, double r, double r2, std::vector<Neighbor>& out) const {
+        if (hi - lo <= kLeaf) {
+            for (std::size_t i = lo; i < hi; ++i) {
+                Best b = candidate(i, q);
+                if (b.dist2 <= r2) out.push_back(Neighbor{ b.vertex, std::sqrt(b.dist2) });
+            }
+            return;
+        }
+        std::size_t mid = lo + (hi - lo) / 2;
+        int axis = _axis[mid];
+        double diff = coord(q, axis) - coord(mid, axis);
+        Best b = candidate(mid, q);
+        if (b.dist2 <= r2) out.push_back(Neighbor{ b.vertex, std::sqrt(b.dist2) });
+        if (diff <= r) radius(lo, mid, q, r, r2, out);
+        if (diff >= -r) radius(mid + 1, hi, q, r, r2, out);
+    }
+
+    std::vector<double> _x, _y, _z;       // points dans l'ordre de l'arbre
+    std::vector<std::uint32_t> _vertex;   // sommet de chaque point
+    std::vector<std::uint8_t> _axis;      // axe de coupe du milieu de chaque intervalle
+};
+
+#endif
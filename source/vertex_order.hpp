@@ -0,0 +1,267 @@
+#ifndef VERTEX_ORDER_HPP
+#define VERTEX_ORDER_HPP
+
+// Renumérotation des sommets pour la localité mémoire : au chargement les sommets sont
+// rangés dans l'ordre des lignes de nodes.csv, souvent sans rapport avec la topologie,
+// et les voisins d'un sommet tombent loin dans les tableaux indexés par sommet
+// (coordonnées, distances, prédécesseurs, états du DFS, listes d'adjacence).
+// - rcm : Reverse Cuthill-McKee (BFS depuis un sommet pseudo-périphérique de chaque
+//   composante, voisins par degré croissant, ordre final inversé) : les voisins d'un
+//   sommet ont des indices proches (largeur de bande réduite)
+// - morton : courbe de Morton (ordre Z) sur x, y, z quantifiés sur 21 bits : des sommets
+//   proches dans l'espace ont des indices proches, sans parcourir les arêtes (adapté aux
+//   graphes géométriques dont les arêtes relient des points voisins)
+// Graphe orienté (DirectedGraph) : le BFS de rcm ne suit que les arcs sortants, et
+// chaque BFS part d'un sommet pas encore placé.
+// Le graphe est reconstruit avec les sommets permutés et les arêtes rangées par extrémité ;
+// chaque sommet garde son ID du CSV (NodeIdMap reconstruite), toutes les
+// sorties (paths.csv, DOT, rapport) restent donc en IDs d'origine.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "graph_types.hpp"
+#include "graph_io.hpp"
+#include "metrics.hpp"
+
+enum class VertexOrder { None, Rcm, Morton };
+
+inline bool parseVertexOrder(const std::string& name, VertexOrder& order) {
+    if (name == "none") order = VertexOrder::None;
+    else if (name == "rcm") order = VertexOrder::Rcm;
+    else if (name == "morton") order = VertexOrder::Morton;
+    else return false;
+    return true;
+}
+
+inline const char* vertexOrderName(VertexOrder order) {
+    switch (order) {
+    case VertexOrder::Rcm: return "rcm";
+    case VertexOrder::Morton: return "morton";
+    default: return "none";
+    }
+}
+
+namespace order_detail {
+
+// BFS depuis root sur sa composante : profondeur atteinte et sommet de plus petit degré
+// du dernier niveau (candidat suivant pour un sommet pseudo-périphérique)
+template <class G>
+std::pair<std::size_t, std::size_t> farthestLevel(const G& g, std::size_t root,
+                                                  const std::vector<std::uint32_t>& degree,
+                                                  std::vector<std::uint32_t>& mark, std::uint32_t epoch,
+                                                  std::vector<std::size_t>& queue) {
+    queue.clear();
+    queue.push_back(root);
+    mark[root] = epoch;
+    std::size_t depth = 0, levelBegin = 0;
+    typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+    while (true) {
+        const std::size_t levelEnd = queue.size();
+        for (std::size_t head = levelBegin; head < levelEnd; ++head) {
+            for (boost::tie(ei, ei_end) = boost::out_edges(queue[head], g); ei != ei_end; ++ei) {
+                std::size_t v = boost::target(*ei, g);
+                if (mark[v] == epoch) continue;
+                mark[v] = epoch;
+                queue.push_back(v);
+            }
+        }
+        if (queue.size() == levelEnd) {
+            std::size_t best = queue[levelBegin];
+            for (std::size_t k = levelBegin + 1; k < levelEnd; ++k) {
+                if (degree[queue[k]] < degree[best]) best = queue[k];
+            }
+            return std::make_pair(depth, best);
+        }
+        levelBegin = levelEnd;
+        ++depth;
+    }
+}
+
+} // namespace order_detail
+
+// order[k] = sommet placé en position k
+// par composante : départ pseudo-périphérique (George-Liu : on repart du dernier niveau
+// du BFS tant que la profondeur augmente), puis BFS où les voisins non placés d'un
+// sommet sont ajoutés par degré croissant ; l'ordre complet est enfin inversé
+template <class G>
+std::vector<std::size_t> rcmOrder(const G& g) {
+    const std::size_t n = boost::num_vertices(g);
+    std::vector<std::uint32_t> degree(n), mark(n, 0);
+    for (std::size_t v = 0; v < n; ++v) degree[v] = static_cast<std::uint32_t>(boost::out_degree(v, g));
+    std::vector<char> placed(n, 0);
+    std::vector<std::size_t> order, queue;
+    order.reserve(n);
+    std::uint32_t epoch = 0;
+    auto byDegree = [&degree](std::size_t a, std::size_t b) {
+        return degree[a] < degree[b] || (degree[a] == degree[b] && a < b);
+    };
+    typename boost::graph_traits<G>::out_edge_iterator ei, ei_end;
+    for (std::size_t start = 0; start < n; ++start) {
+        if (placed[start]) continue;
+        std::size_t root = start;
+        if (degree[start] > 0) {
+            std::pair<std::size_t, std::size_t> last = order_detail::farthestLevel(g, root, degree, mark, ++epoch, queue);
+            for (int round = 0; round < 8; ++round) {
+                std::pair<std::size_t, std::size_t> next =
+                    order_detail::farthestLevel(g, last.second, degree, mark, ++epoch, queue);
+                // graphe orienté : le BFS peut atteindre des sommets déjà placés
+                if (next.first <= last.first || placed[last.second]) break;
+                root = last.second;
+                last = next;
+            }
+        }
+        std::size_t head = order.size();
+        order.push_back(root);
+        placed[root] = 1;
+        for (; head < order.size(); ++head) {
+            const std::size_t first = order.size();
+            for (boost::tie(ei, ei_end) = boost::out_edges(order[head], g); ei != ei_end; ++ei) {
+                std::size_t v = boost::target(*ei, g);
+                if (placed[v]) continue;
+                placed[v] = 1;
+                order.push_back(v);
+            }
+            std::sort(order.begin() + first, order.end(), byDegree);
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+// Intercale les 21 bits de poids faible de v avec deux zéros entre chaque bit
+inline std::uint64_t spreadBits3(std::uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8) & 0x100f00f00f00f00fULL;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+}
+
+template <class G>
+std::vector<std::size_t> mortonOrder(const G& g) {
+    const std::size_t n = boost::num_vertices(g);
+    std::vector<std::size_t> order(n);
+    if (n == 0) return order;
+    double low[3] = { g[0].x, g[0].y, g[0].z }, high[3] = { g[0].x, g[0].y, g[0].z };
+    for (std::size_t v = 1; v < n; ++v) {
+        const double c[3] = { g[v].x, g[v].y, g[v].z };
+        for (int a = 0; a < 3; ++a) {
+            low[a] = std::min(low[a], c[a]);
+            high[a] = std::max(high[a], c[a]);
+        }
+    }
+    // même échelle sur les trois axes : la courbe ne déforme pas l'espace
+    const double extent = std::max({ high[0] - low[0], high[1] - low[1], high[2] - low[2] });
+    const double scale = extent > 0 ? 2097151.0 / extent : 0.0;
+    std::vector<std::uint64_t> code(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        const double c[3] = { g[v].x, g[v].y, g[v].z };
+        std::uint64_t key = 0;
+        for (int a = 0; a < 3; ++a) {
+            double q = std::floor((c[a] - low[a]) * scale);  // NaN => 0
+            key |= spreadBits3(q >= 0 ? static_cast<std::uint64_t>(q) : 0) << a;
+        }
+        code[v] = key;
+        order[v] = v;
+    }
+    std::sort(order.begin(), order.end(), [&code](std::size_t a, std::size_t b) {
+        return code[a] < code[b] || (code[a] == code[b] && a < b);
+    });
+    return order;
+}
+
+// Écart moyen |u - v| entre les extrémités des arêtes : plus il est petit, plus les
+// voisins sont proches en mémoire
+template <class G>
+double meanEdgeSpan(const G& g) {
+    if (boost::num_edges(g) == 0) return 0.0;
+    double sum = 0;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // edge_iterator orienté de Boost, voir graph_types.hpp
+    typename boost::graph_traits<G>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei) {
+        std::size_t u = boost::source(*ei, g), v = boost::target(*ei, g);
+        sum += u > v ? u - v : v - u;
+    }
+#pragma GCC diagnostic pop
+    return sum / boost::num_edges(g);
+}
+
+// Reconstruit g avec le sommet order[k] en position k, puis les arêtes rangées par
+// extrémité (plus petite, puis plus grande, puis ordre d'origine ; source puis cible pour
+// un arc) : les poids et la liste d'arêtes sont alors lus dans l'ordre des sommets pendant
+// les parcours, au lieu de l'ordre de edges.csv (le CSR figé ensuite hérite du même ordre)
+template <class D>
+void permuteVertices(BasicGraph<D>& g, const std::vector<std::size_t>& order) {
+    const bool directed = boost::is_directed_graph<BasicGraph<D>>::value;
+    const std::size_t n = boost::num_vertices(g);
+    const std::size_t m = boost::num_edges(g);
+    std::vector<std::size_t> position(n);
+    for (std::size_t k = 0; k < n; ++k) position[order[k]] = k;
+
+    std::vector<NodeInfo> nodes(n);
+    for (std::size_t k = 0; k < n; ++k) nodes[k] = g[order[k]];
+    EdgeBatch batch;
+    std::vector<EdgeInfo> info;
+    batch.reserve(m);
+    info.reserve(m);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // edge_iterator orienté de Boost, voir graph_types.hpp
+    typename boost::graph_traits<BasicGraph<D>>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei) {
+        batch.push(static_cast<int>(position[boost::source(*ei, g)]), static_cast<int>(position[boost::target(*ei, g)]));
+        info.push_back(g[*ei]);
+    }
+#pragma GCC diagnostic pop
+    assignNodes(g, nodes);  // l'ancien graphe est libéré avant la reconstruction
+
+    // tri par dénombrement sur la plus petite extrémité (stable), puis chaque tranche
+    // par la plus grande
+    auto low = [&batch, directed](std::size_t i) {
+        return static_cast<std::size_t>(directed ? batch.source[i] : std::min(batch.source[i], batch.target[i]));
+    };
+    auto high = [&batch, directed](std::size_t i) {
+        return static_cast<std::size_t>(directed ? batch.target[i] : std::max(batch.source[i], batch.target[i]));
+    };
+    std::vector<std::size_t> start(n + 1, 0);
+    for (std::size_t i = 0; i < m; ++i) ++start[low(i) + 1];
+    for (std::size_t v = 0; v < n; ++v) start[v + 1] += start[v];
+    std::vector<std::uint32_t> sorted(m);
+    {
+        std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+        for (std::size_t i = 0; i < m; ++i) sorted[fill[low(i)]++] = static_cast<std::uint32_t>(i);
+    }
+    for (std::size_t v = 0; v < n; ++v) {
+        std::sort(sorted.begin() + start[v], sorted.begin() + start[v + 1], [&high](std::uint32_t a, std::uint32_t b) {
+            return high(a) < high(b) || (high(a) == high(b) && a < b);
+        });
+    }
+
+    reserveOutEdges(g, &batch, &batch + 1);
+    for (std::uint32_t i : sorted) boost::add_edge(batch.source[i], batch.target[i], info[i], g);
+}
+
+// --reorder : renumérote g selon l'ordre demandé, avant l'analyse (ou le gel en CSR)
+template <class D>
+void reorderVertices(BasicGraph<D>& g, VertexOrder order) {
+    if (order == VertexOrder::None) return;
+    ScopedPhase phase(Phase::Reorder);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    double before = meanEdgeSpan(g);
+    permuteVertices(g, order == VertexOrder::Rcm ? rcmOrder(g) : mortonOrder(g));
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::cout << "Renumérotation " << vertexOrderName(order) << " : écart moyen entre voisins "
+              << before << " -> " << meanEdgeSpan(g) << " en "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+}
+
+#endif
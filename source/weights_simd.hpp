@@ -0,0 +1,155 @@
+#ifndef WEIGHTS_SIMD_HPP
+#define WEIGHTS_SIMD_HPP
+
+// Calcul en lot des poids des arêtes (distance euclidienne 3D)
+// les coordonnées des extrémités sont récupérées par gather puis la distance est
+// calculée 4 (AVX2) ou 8 (AVX-512) arêtes à la fois ; version scalaire sinon.
+// Le choix se fait à l'exécution selon le CPU, le reste du code est compilé sans -mavx.
+// Pas de FMA (fp-contract=off, AVX-512 en fournit) : les trois versions donnent exactement
+// les mêmes doubles que la formule scalaire std::sqrt(dx*dx + dy*dy + dz*dz).
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GRAPHCPP_X86_SIMD 1
+#endif
+
+enum class WeightKernel { Scalar, Avx2, Avx512 };
+
+inline const char* weightKernelName(WeightKernel k) {
+    switch (k) {
+        case WeightKernel::Avx512: return "avx512";
+        case WeightKernel::Avx2: return "avx2";
+        default: return "scalaire";
+    }
+}
+
+// Version de référence, utilisée aussi pour la fin des tableaux (m % largeur)
+template <class Index>
+inline void edgeWeightsScalar(const double* x, const double* y, const double* z,
+                              const Index* s, const Index* t, double* w,
+                              std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        double dx = x[s[i]] - x[t[i]];
+        double dy = y[s[i]] - y[t[i]];
+        double dz = z[s[i]] - z[t[i]];
+        // pythogore
+        w[i] = std::sqrt(dx*dx + dy*dy + dz*dz);
+    }
+}
+
+#ifdef GRAPHCPP_X86_SIMD
+
+// Chargement de 4 / 8 indices (32 ou 64 bits) et gather des coordonnées correspondantes
+// (variantes masquées avec source à zéro : mêmes instructions, sans valeur non initialisée)
+__attribute__((target("avx2")))
+inline __m256d gather4(const double* base, const std::int32_t* idx) {
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)),
+                                    _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+}
+__attribute__((target("avx2")))
+inline __m256d gather4(const double* base, const std::int64_t* idx) {
+    return _mm256_mask_i64gather_pd(_mm256_setzero_pd(), base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)),
+                                    _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+}
+__attribute__((target("avx512f")))
+inline __m512d gather8(const double* base, const std::int32_t* idx) {
+    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF,
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), base, 8);
+}
+__attribute__((target("avx512f")))
+inline __m512d gather8(const double* base, const std::int64_t* idx) {
+    return _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, _mm512_loadu_si512(idx), base, 8);
+}
+
+template <class Index>
+__attribute__((target("avx2"), optimize("fp-contract=off")))
+void edgeWeightsAvx2(const double* x, const double* y, const double* z,
+                     const Index* s, const Index* t, double* w, std::size_t m) {
+    std::size_t i = 0;
+    for (; i + 4 <= m; i += 4) {
+        __m256d dx = _mm256_sub_pd(gather4(x, s + i), gather4(x, t + i));
+        __m256d dy = _mm256_sub_pd(gather4(y, s + i), gather4(y, t + i));
+        __m256d dz = _mm256_sub_pd(gather4(z, s + i), gather4(z, t + i));
+        __m256d d2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+                                   _mm256_mul_pd(dz, dz));
+        _mm256_storeu_pd(w + i, _mm256_sqrt_pd(d2));
+    }
+    edgeWeightsScalar(x, y, z, s, t, w, i, m);
+}
+
+template <class Index>
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+void edgeWeightsAvx512(const double* x, const double* y, const double* z,
+                       const Index* s, const Index* t, double* w, std::size_t m) {
+    std::size_t i = 0;
+    for (; i + 8 <= m; i += 8) {
+        __m512d dx = _mm512_sub_pd(gather8(x, s + i), gather8(x, t + i));
+        __m512d dy = _mm512_sub_pd(gather8(y, s + i), gather8(y, t + i));
+        __m512d dz = _mm512_sub_pd(gather8(z, s + i), gather8(z, t + i));
+        __m512d d2 = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)),
+                                   _mm512_mul_pd(dz, dz));
+        _mm512_storeu_pd(w + i, _mm512_maskz_sqrt_pd(0xFF, d2));
+    }
+    edgeWeightsScalar(x, y, z, s, t, w, i, m);
+}
+
+#endif
+
+// Meilleur noyau disponible sur le CPU courant (détecté une seule fois)
+inline WeightKernel bestWeightKernel() {
+#ifdef GRAPHCPP_X86_SIMD
+    static const WeightKernel best = __builtin_cpu_supports("avx512f") ? WeightKernel::Avx512
+                                   : __builtin_cpu_supports("avx2") ? WeightKernel::Avx2
+                                   : WeightKernel::Scalar;
+    return best;
+#else
+    return WeightKernel::Scalar;
+#endif
+}
+
+inline bool weightKernelSupported(WeightKernel k) {
+    switch (k) {
+        case WeightKernel::Avx512: return bestWeightKernel() == WeightKernel::Avx512;
+        case WeightKernel::Avx2: return bestWeightKernel() != WeightKernel::Scalar;
+        default: return true;
+    }
+}
+
+// w[i] = distance entre les sommets s[i] et t[i], pour i dans [0, m)
+// Index = int32 (EdgeBatch du chargement) ou int64/size_t (tableaux du CSR)
+template <class Index>
+void computeWeightsBatch(const double* x, const double* y, const double* z,
+                         const Index* s, const Index* t, double* w, std::size_t m,
+                         WeightKernel kernel = bestWeightKernel()) {
+    static_assert(sizeof(Index) == 4 || sizeof(Index) == 8, "indices 32 ou 64 bits");
+#ifdef GRAPHCPP_X86_SIMD
+    typedef typename std::conditional<sizeof(Index) == 4, std::int32_t, std::int64_t>::type Lane;
+    const Lane* sl = reinterpret_cast<const Lane*>(s);
+    const Lane* tl = reinterpret_cast<const Lane*>(t);
+    if (kernel == WeightKernel::Avx512) return edgeWeightsAvx512(x, y, z, sl, tl, w, m);
+    if (kernel == WeightKernel::Avx2) return edgeWeightsAvx2(x, y, z, sl, tl, w, m);
+#endif
+    edgeWeightsScalar(x, y, z, s, t, w, 0, m);
+}
+
+// Poids en float (graphe compact, voir graph_config.hpp) : calcul en double par blocs
+// puis arrondi, mêmes valeurs que les poids double convertis
+template <class Index>
+void computeWeightsBatch(const double* x, const double* y, const double* z,
+                         const Index* s, const Index* t, float* w, std::size_t m,
+                         WeightKernel kernel = bestWeightKernel()) {
+    const std::size_t kBlock = 1024;
+    double block[kBlock];
+    for (std::size_t i = 0; i < m; i += kBlock) {
+        const std::size_t count = m - i < kBlock ? m - i : kBlock;
+        computeWeightsBatch(x, y, z, s + i, t + i, block, count, kernel);
+        for (std::size_t k = 0; k < count; ++k) w[i + k] = static_cast<float>(block[k]);
+    }
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef WORKSPACE_POOL_HPP
+#define WORKSPACE_POOL_HPP
+
+// Réserve de workspaces (DijkstraWorkspace, AStarWorkspace...) partagée d'un lot de
+// requêtes à l'autre : chaque worker emprunte un workspace au début du lot et le rend
+// à la fin, au lieu d'allouer puis libérer ses tableaux de n cases à chaque appel.
+// Un workspace rendu garde ses pages déjà touchées et se remet à zéro par époque à la
+// requête suivante ; le mode serveur ne paie plus allocation et défauts de page par lot.
+// Au plus un workspace inactif par coeur est gardé ; ceux d'une autre taille de graphe
+// (graphe rechargé, sous-graphe) sont libérés au prochain emprunt.
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template <class Workspace>
+class WorkspacePool {
+public:
+    // Workspace emprunté, rendu à la réserve à la destruction
+    class Lease {
+    public:
+        Lease(std::unique_ptr<Workspace> ws, std::size_t n) : _ws(std::move(ws)), _n(n) {}
+        ~Lease() {
+            if (_ws) release(std::move(_ws), _n);
+        }
+        Lease(Lease&&) = default;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Workspace& operator*() const { return *_ws; }
+        Workspace* operator->() const { return _ws.get(); }
+
+    private:
+        std::unique_ptr<Workspace> _ws;
+        std::size_t _n;
+    };
+
+    // Workspace pour un graphe de n sommets : réutilisé s'il y en a un, sinon alloué
+    static Lease acquire(std::size_t n) {
+        std::unique_ptr<Workspace> stale;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            while (!_idle.empty()) {
+                Entry entry = std::move(_idle.back());
+                _idle.pop_back();
+                if (entry.first == n) return Lease(std::move(entry.second), n);
+                stale = std::move(entry.second);  // libéré hors du verrou
+            }
+        }
+        stale.reset();
+        return Lease(std::make_unique<Workspace>(n), n);
+    }
+
+    // Libère les workspaces inactifs
+    static void clear() {
+        std::vector<Entry> idle;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            idle.swap(_idle);
+        }
+    }
+
+    static std::size_t idle() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _idle.size();
+    }
+
+private:
+    typedef std::pair<std::size_t, std::unique_ptr<Workspace>> Entry;
+
+    static void release(std::unique_ptr<Workspace> ws, std::size_t n) {
+        const std::size_t capacity = std::max(1u, std::thread::hardware_concurrency());
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_idle.size() < capacity) _idle.emplace_back(n, std::move(ws));
+        // sinon ws est libéré au retour, après le verrou
+    }
+
+    inline static std::mutex _mutex;
+    inline static std::vector<Entry> _idle;
+};
+
+#endif